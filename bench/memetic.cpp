@@ -0,0 +1,174 @@
+#include "ga/algorithm.hpp"
+#include "ga/permutation.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+using tour = std::vector<int>;
+
+// Cities are evenly spaced on a circle, so the optimal tour visits them in order.
+class circle
+{
+public:
+  using individual_type = tour;
+  using generator_type = std::mt19937;
+  using fitness_type = double;
+
+  explicit circle(std::size_t n)
+    : chord(n)
+  {
+    for (std::size_t d = 0u; d < n; ++d)
+      chord[d] = std::sqrt(2.0 - 2.0 * std::cos(2.0 * pi * d / static_cast<double>(n)));
+  }
+
+  auto evaluate(const individual_type& x, generator_type&) const -> double
+  {
+    auto total = 0.0;
+    for (std::size_t i = 0u; i < x.size(); ++i)
+      total += distance(x[i], x[(i + 1u) % x.size()]);
+    return total;
+  }
+
+  auto mutate(individual_type& x, generator_type& g) const -> void
+  {
+    if (ga::draw(0.3, g))
+      ga::permutation::inversion_mutation(x, g);
+  }
+
+  auto recombine(const individual_type& parent1, const individual_type& parent2,
+                 generator_type& g) const -> std::array<individual_type, 2u>
+  {
+    return ga::permutation::order_crossover(parent1, parent2, g);
+  }
+
+  // First shortening 2-opt move, scanning cities in order and taking the best move from
+  // each.  Deterministic, so Baldwinian fitness is a function of the individual.
+  auto improve(individual_type& x, double& fitness, generator_type&) const -> void
+  {
+    const auto n = x.size();
+    for (std::size_t i = 0u; i < n; ++i)
+    {
+      auto best = 0.0;
+      auto best_j = i;
+      for (std::size_t j = i + 2u; j < n; ++j)
+      {
+        if (i == 0u && j == n - 1u)
+          continue;
+        const auto delta = distance(x[i], x[j]) + distance(x[i + 1u], x[(j + 1u) % n]) -
+                           distance(x[i], x[i + 1u]) - distance(x[j], x[(j + 1u) % n]);
+        if (delta < best)
+        {
+          best = delta;
+          best_j = j;
+        }
+      }
+      if (best_j != i)
+      {
+        std::reverse(x.begin() + static_cast<std::ptrdiff_t>(i + 1u),
+                     x.begin() + static_cast<std::ptrdiff_t>(best_j + 1u));
+        fitness += best;
+        return;
+      }
+    }
+  }
+
+  auto optimum() const -> double { return chord.size() * chord[1u]; }
+
+private:
+  static constexpr double pi = 3.141592653589793;
+
+  auto distance(int a, int b) const -> double
+  {
+    return chord[static_cast<std::size_t>(std::abs(a - b))];
+  }
+
+  std::vector<double> chord;
+};
+
+constexpr double circle::pi;
+
+struct outcome
+{
+  unsigned generations;
+  double seconds;
+  double best;
+};
+
+static auto run(std::size_t n, ga::improvement_policy policy, double target,
+                unsigned max_generations) -> outcome
+{
+  auto g = std::mt19937{17};
+
+  auto population = std::vector<tour>(100u);
+  for (auto& x : population)
+  {
+    x.resize(n);
+    std::iota(x.begin(), x.end(), 0);
+    std::shuffle(x.begin(), x.end(), g);
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  auto model = ga::make_algorithm(circle{n}, std::move(population), 5u, std::move(g));
+  model.improvement() = policy;
+
+  // Under Baldwinian write-back, stored tours are never improved, so the solution is the
+  // best tour after local search.  Otherwise, it's the best tour itself.
+  const auto best_length = [&model, &policy]() {
+    auto x = model.population().front().x;
+    auto g = std::mt19937{};
+    auto fitness = model.problem().evaluate(x, g);
+    if (policy.mode == ga::write_back::baldwinian)
+      for (std::size_t step = 0u; step < policy.step_budget; ++step)
+        model.problem().improve(x, fitness, g);
+    return model.problem().evaluate(x, g);
+  };
+
+  auto generations = 0u;
+  while (generations < max_generations && best_length() > target)
+  {
+    model.iterate();
+    ++generations;
+  }
+
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return {generations, std::chrono::duration<double>(elapsed).count(), best_length()};
+}
+
+int main()
+{
+  static constexpr std::size_t city_count = 100u;
+  static constexpr unsigned max_generations = 5000u;
+
+  const auto target = 1.1 * circle{city_count}.optimum();
+
+  auto none = ga::improvement_policy{};
+
+  auto lamarckian = ga::improvement_policy{};
+  lamarckian.offspring_rate = 0.2;
+  lamarckian.elite_rate = 1.0;
+  lamarckian.step_budget = 100u;
+
+  auto baldwinian = lamarckian;
+  baldwinian.mode = ga::write_back::baldwinian;
+
+  auto parallel = lamarckian;
+  parallel.thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+  std::printf("time to reach %.4f (optimum %.4f, %zu cities)\n", target,
+              circle{city_count}.optimum(), city_count);
+  std::printf("%-22s %12s %12s %12s\n", "mode", "generations", "seconds", "best");
+
+  const auto report = [&](const char* name, const ga::improvement_policy& policy) {
+    const auto r = run(city_count, policy, target, max_generations);
+    std::printf("%-22s %12u %12.3f %12.4f\n", name, r.generations, r.seconds, r.best);
+  };
+
+  report("plain", none);
+  report("lamarckian", lamarckian);
+  report("baldwinian", baldwinian);
+  report("lamarckian (threads)", parallel);
+}
@@ -0,0 +1,73 @@
+#include "ga/permutation.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+using tour = std::vector<int>;
+
+// Runs `f` enough times to process about `budget` genes and returns the mean time per
+// call in nanoseconds.
+template <typename F> static auto measure(std::size_t n, F f) -> double
+{
+  static constexpr std::size_t budget = 5000000u;
+  const auto repetitions = std::max<std::size_t>(budget / n, 1u);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0u; i < repetitions; ++i)
+    f();
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         static_cast<double>(repetitions);
+}
+
+int main()
+{
+  auto g = std::mt19937{17};
+
+  // Crossovers run in linear time, so they are reported per gene.  Swap mutation takes
+  // constant time and inversion mutation reverses n / 3 genes on average, so mutations
+  // are reported per call.
+  std::printf("%8s %10s %10s %10s %10s | %10s %10s\n", "n", "ox", "pmx", "cx", "erx",
+              "swap", "inversion");
+
+  for (const std::size_t n : {10u, 100u, 1000u, 10000u, 100000u})
+  {
+    auto a = tour(n);
+    std::iota(a.begin(), a.end(), 0);
+    auto b = a;
+    std::shuffle(a.begin(), a.end(), g);
+    std::shuffle(b.begin(), b.end(), g);
+
+    // Keeps results alive so the calls are not optimized away.
+    volatile int sink = 0;
+
+    const auto per_gene = [n](double t) { return t / static_cast<double>(n); };
+
+    const auto ox = per_gene(measure(n, [&] {
+      sink += ga::permutation::order_crossover(a, b, g)[0][0];
+    }));
+    const auto pmx = per_gene(measure(n, [&] {
+      sink += ga::permutation::partially_mapped_crossover(a, b, g)[0][0];
+    }));
+    const auto cx = per_gene(
+      measure(n, [&] { sink += ga::permutation::cycle_crossover(a, b, g)[0][0]; }));
+    const auto erx = per_gene(
+      measure(n, [&] { sink += ga::permutation::edge_recombination(a, b, g)[0][0]; }));
+    const auto swap = measure(n, [&] {
+      ga::permutation::swap_mutation(a, g);
+      sink += a[0];
+    });
+    const auto inversion = measure(n, [&] {
+      ga::permutation::inversion_mutation(a, g);
+      sink += a[0];
+    });
+
+    std::printf("%8zu %10.3f %10.3f %10.3f %10.3f | %10.3f %10.3f\n", n, ox, pmx, cx,
+                erx, swap, inversion);
+  }
+
+  std::printf("(nanoseconds per gene | nanoseconds per call)\n");
+}
@@ -4,13 +4,18 @@
 #define GA_ALGORITHM_HPP
 
 #include <ga/meta.hpp>
+#include <ga/parallel.hpp>
 #include <ga/problem.hpp>
 #include <ga/type.hpp>
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
+#include <limits>
+#include <numeric>
 #include <random>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -44,6 +49,24 @@ private:
   std::size_t elite_count_;
   generator_type generator_;
 
+  improvement_policy improvement_;
+  std::vector<std::size_t> improve_indexes_;
+  std::vector<typename generator_type::result_type> improve_seeds_;
+
+  resampling_policy resampling_;
+  std::vector<sample_statistics> samples_;
+  std::vector<std::size_t> order_;
+  std::vector<solution_type> sorted_population_;
+  std::vector<sample_statistics> sorted_samples_;
+  std::vector<std::size_t> uncertain_;
+
+  std::size_t avoided_evaluations_ = 0u;
+  std::vector<bool> bounded_;
+
+  breeding_policy breeding_;
+  std::vector<typename generator_type::result_type> breed_seeds_;
+  detail::worker_pool breed_workers_;
+
 public:
   algorithm(T problem, std::vector<individual_type> population,
             const std::size_t elite_count, generator_type generator)
@@ -83,6 +106,288 @@ public:
   auto iterate() -> void
   {
     // == Mating Selection, Recombination and Mutation ==
+    const auto expected_size = population_.size();
+    breed(std::is_default_constructible<individual_type>{});
+
+    evaluate_offspring(meta::StagedEvaluation<T>{});
+
+    if (population_.size() != expected_size ||
+        next_population_.size() != expected_size - elite_count_ ||
+        next_fitness_.size() != expected_size - elite_count_)
+      throw std::runtime_error{"evaluation step has changed expected population size"};
+
+    seed_samples(meta::NoisyEvaluation<T>{});
+
+    improve_offspring(meta::Improvement<T>{});
+    improve_elite(meta::Improvement<T>{});
+
+    {
+      auto ind_it = next_population_.begin();
+      auto fit_it = next_fitness_.begin();
+
+      auto sol_it = population_.begin() + elite_count_;
+      const auto end = population_.end();
+
+      while (sol_it != end)
+        *sol_it++ = solution_type{std::move(*ind_it++), std::move(*fit_it++)};
+    }
+
+    next_population_.clear();
+    next_fitness_.clear();
+
+    resample(meta::NoisyEvaluation<T>{});
+
+    sort_population();
+  }
+
+  auto population() const noexcept -> const std::vector<solution_type>&
+  {
+    return population_;
+  }
+
+  auto problem() noexcept -> T& { return problem_.operator T&(); }
+  auto problem() const noexcept -> const T& { return problem_.operator const T&(); }
+
+  auto generator() noexcept -> generator_type& { return generator_; }
+  auto generator() const noexcept -> const generator_type& { return generator_; }
+
+  auto elite_count() noexcept -> std::size_t& { return elite_count_; }
+  auto elite_count() const noexcept -> std::size_t { return elite_count_; }
+
+  auto improvement() noexcept -> improvement_policy&
+  {
+    static_assert(meta::Improvement<T>::value, "Problem type doesn't define improve");
+    return improvement_;
+  }
+  auto improvement() const noexcept -> const improvement_policy&
+  {
+    static_assert(meta::Improvement<T>::value, "Problem type doesn't define improve");
+    return improvement_;
+  }
+
+  auto resampling() noexcept -> resampling_policy&
+  {
+    static_assert(meta::NoisyEvaluation<T>::value,
+                  "Problem type doesn't support resampling");
+    return resampling_;
+  }
+  auto resampling() const noexcept -> const resampling_policy&
+  {
+    static_assert(meta::NoisyEvaluation<T>::value,
+                  "Problem type doesn't support resampling");
+    return resampling_;
+  }
+
+  auto breeding() noexcept -> breeding_policy& { return breeding_; }
+  auto breeding() const noexcept -> const breeding_policy& { return breeding_; }
+
+  // Number of children whose full evaluation was skipped because of their bound.
+  auto avoided_evaluations() const noexcept -> std::size_t
+  {
+    return avoided_evaluations_;
+  }
+
+  // Statistics of the fitness samples of each solution, in the same order as
+  // `population()`.  Empty unless resampling is enabled.
+  auto samples() const noexcept -> const std::vector<sample_statistics>&
+  {
+    return samples_;
+  }
+
+private:
+  auto sort_population() -> void
+  {
+    if (samples_.empty())
+    {
+      std::partial_sort(population_.begin(), population_.begin() + elite_count_,
+                        population_.end(),
+                        [](const solution_type& a, const solution_type& b) {
+                          return a.fitness < b.fitness;
+                        });
+      return;
+    }
+
+    // Solutions and their statistics must be kept aligned, so we sort indexes instead.
+    order_.resize(population_.size());
+    std::iota(order_.begin(), order_.end(), std::size_t{0u});
+    std::partial_sort(order_.begin(), order_.begin() + elite_count_, order_.end(),
+                      [this](std::size_t i, std::size_t j) {
+                        return population_[i].fitness < population_[j].fitness;
+                      });
+
+    sorted_population_.clear();
+    sorted_samples_.clear();
+    for (const auto i : order_)
+    {
+      sorted_population_.push_back(std::move(population_[i]));
+      sorted_samples_.push_back(samples_[i]);
+    }
+
+    population_.swap(sorted_population_);
+    samples_.swap(sorted_samples_);
+  }
+
+  // == Noisy Fitness ==
+  // Each solution's fitness is the mean of its samples, which only come from `evaluate`.
+  // Elites keep their samples and each child starts from its single evaluation, both
+  // placed where the solution will be once children replace the non-elites.  Improved
+  // solutions start over.  Every solution gets at least `min_samples` samples.  Then,
+  // while the budget lasts, solutions whose confidence interval overlaps the ones on the
+  // other side of the elite boundary are resampled.
+  auto seed_samples(std::false_type) -> void {}
+  auto seed_samples(std::true_type) -> void
+  {
+    if (resampling_.max_samples <= 1u)
+    {
+      samples_.clear();
+      return;
+    }
+
+    const auto size = population_.size();
+    if (samples_.size() != size)
+      samples_.assign(size, sample_statistics{});
+
+    for (std::size_t i = 0u; i < next_fitness_.size(); ++i)
+    {
+      const auto fitness = static_cast<double>(next_fitness_[i]);
+      samples_[elite_count_ + i] = sample_statistics{1u, fitness, 0.0};
+    }
+  }
+
+  auto resample(std::false_type) -> void {}
+  auto resample(std::true_type) -> void
+  {
+    if (samples_.empty())
+      return;
+
+    const auto size = population_.size();
+    const auto min_samples = std::max<std::size_t>(
+      std::min(resampling_.min_samples, resampling_.max_samples), 1u);
+    for (std::size_t i = 0u; i < size; ++i)
+      while (samples_[i].count < min_samples)
+        sample(i);
+
+    if (elite_count_ == 0u)
+      return;
+
+    auto budget = resampling_.evaluation_budget;
+    while (budget > 0u)
+    {
+      sort_population();
+
+      auto elite_upper = -std::numeric_limits<double>::infinity();
+      for (std::size_t i = 0u; i < elite_count_; ++i)
+        elite_upper = std::max(elite_upper, samples_[i].mean + half_width(samples_[i]));
+
+      auto other_lower = std::numeric_limits<double>::infinity();
+      for (auto i = elite_count_; i < size; ++i)
+        other_lower = std::min(other_lower, samples_[i].mean - half_width(samples_[i]));
+
+      uncertain_.clear();
+      for (std::size_t i = 0u; i < size; ++i)
+      {
+        if (samples_[i].count >= resampling_.max_samples)
+          continue;
+        const auto h = half_width(samples_[i]);
+        if (i < elite_count_ ? samples_[i].mean + h > other_lower
+                             : samples_[i].mean - h < elite_upper)
+          uncertain_.push_back(i);
+      }
+
+      if (uncertain_.empty())
+        break;
+
+      for (const auto i : uncertain_)
+      {
+        sample(i);
+        if (--budget == 0u)
+          break;
+      }
+    }
+  }
+
+  auto sample(std::size_t i) -> void
+  {
+    auto& s = population_[i];
+    auto& stats = samples_[i];
+
+    const auto value =
+      static_cast<double>(problem().evaluate(const_cast<const individual_type&>(s.x),
+                                             generator_));
+
+    // Welford's online update.
+    ++stats.count;
+    const auto delta = value - stats.mean;
+    stats.mean += delta / static_cast<double>(stats.count);
+    stats.m2 += delta * (value - stats.mean);
+
+    s.fitness = static_cast<fitness_type>(stats.mean);
+  }
+
+  auto half_width(const sample_statistics& stats) const -> double
+  {
+    const auto n = static_cast<double>(stats.count);
+
+    if (resampling_.bound == race_bound::hoeffding)
+      return resampling_.range * std::sqrt(std::log(2.0 / resampling_.delta) / (2.0 * n));
+
+    if (stats.count < 2u)
+      return std::numeric_limits<double>::infinity();
+    return resampling_.width * std::sqrt(stats.m2 / (n - 1.0) / n);
+  }
+
+  auto reset_samples(std::size_t, std::false_type) -> void {}
+  auto reset_samples(std::size_t i, std::true_type) -> void
+  {
+    if (!samples_.empty())
+      samples_[i] = sample_statistics{};
+  }
+
+  // == Breeding ==
+  // In parallel, offspring slots are split in blocks of `block_size` children, rounded up
+  // to whole recombinations.  Each block is bred with its own engine seeded from the main
+  // one, so results depend on the block size but not on the number of threads.  As in the
+  // serial loop, surplus children are only discarded at the end of the last block.
+  // Threads take contiguous ranges of blocks, so each one writes to its own slice of the
+  // offspring.  They are kept alive across generations and, if pinned, stay on the same
+  // cores.
+  // The offspring buffer is sized by the calling thread, so pinning only places the
+  // memory that children allocate themselves.
+  //
+  // Individuals must be default-constructible to pre-size the offspring, and the number
+  // of children per recombination must be known at compile time; otherwise, breeding is
+  // serial.
+  auto breed(std::false_type) -> void { breed_serial(); }
+  auto breed(std::true_type) -> void
+  {
+    const auto arity = meta::RecombinationSize<T>::value;
+    if (breeding_.thread_count <= 1u || arity == 0u)
+    {
+      breed_serial();
+      return;
+    }
+
+    const auto offspring = population_.size() - elite_count_;
+    const auto block =
+      (std::max<std::size_t>(breeding_.block_size, 1u) + arity - 1u) / arity * arity;
+    const auto block_count = (offspring + block - 1u) / block;
+
+    next_population_.resize(offspring);
+
+    breed_seeds_.clear();
+    for (std::size_t b = 0u; b < block_count; ++b)
+      breed_seeds_.push_back(generator_());
+
+    breed_workers_.run(block_count, breeding_.thread_count,
+                       [this, block, offspring](std::size_t b) {
+                         auto g = generator_type(breed_seeds_[b]);
+                         breed_slice(b * block, std::min((b + 1u) * block, offspring), g);
+                       },
+                       breeding_.pin_threads);
+  }
+
+  auto breed_serial() -> void
+  {
     // We perform binary tournament selection with replacement.
     auto indexes =
       std::uniform_int_distribution<std::size_t>(0u, population_.size() - 1u);
@@ -113,55 +418,212 @@ public:
           break;
       }
     }
+  }
+
+  auto breed_slice(std::size_t first, std::size_t last, generator_type& g) -> void
+  {
+    auto indexes =
+      std::uniform_int_distribution<std::size_t>(0u, population_.size() - 1u);
+
+    const auto binary_tournament = [&]() -> const individual_type& {
+      const auto i = indexes(g);
+      const auto j = indexes(g);
+      return population_[i].fitness < population_[j].fitness ? population_[i].x
+                                                             : population_[j].x;
+    };
+
+    auto i = first;
+    while (i < last)
+    {
+      const auto& parent1 = binary_tournament();
+      const auto& parent2 = binary_tournament();
+
+      auto children = problem_.recombine(parent1, parent2, g);
+
+      for (auto& child : children)
+      {
+        problem_.mutate(child, g);
+        next_population_[i++] = std::move(child);
+        if (i == last)
+          break;
+      }
+    }
+  }
 
+  // == Evaluation ==
+  // With staged evaluation, children whose lower bound is already worse than the worst
+  // elite can't become elites, so they take the bound as fitness instead of being fully
+  // evaluated.  Since noisy fitness has no such guarantee, it's disabled when resampling.
+  // Improvement would start from the bound, so children selected for it are fully
+  // evaluated first.
+  auto evaluate_offspring(std::false_type) -> void
+  {
     problem_.evaluate(const_cast<const std::vector<individual_type>&>(next_population_),
                       population_, elite_count_, std::back_inserter(next_fitness_),
                       generator_);
+  }
 
-    if (population_.size() != expected_size ||
-        next_population_.size() != expected_size - elite_count_ ||
-        next_fitness_.size() != expected_size - elite_count_)
-      throw std::runtime_error{"evaluation step has changed expected population size"};
+  auto evaluate_offspring(std::true_type) -> void
+  {
+    bounded_.clear();
 
+    if (elite_count_ == 0u || resampling_.max_samples > 1u)
     {
-      auto ind_it = next_population_.begin();
-      auto fit_it = next_fitness_.begin();
+      evaluate_offspring(std::false_type{});
+      return;
+    }
 
-      auto sol_it = population_.begin() + elite_count_;
-      const auto end = population_.end();
+    auto& problem = this->problem();
+    const auto& worst_elite = population_[elite_count_ - 1u].fitness;
 
-      while (sol_it != end)
-        *sol_it++ = solution_type{std::move(*ind_it++), std::move(*fit_it++)};
+    for (const auto& child : next_population_)
+    {
+      auto bound = problem.bound(child, generator_);
+      if (worst_elite < bound)
+      {
+        next_fitness_.push_back(std::move(bound));
+        bounded_.push_back(true);
+        ++avoided_evaluations_;
+      }
+      else
+      {
+        next_fitness_.push_back(problem.evaluate(child, generator_));
+        bounded_.push_back(false);
+      }
     }
+  }
 
-    next_population_.clear();
-    next_fitness_.clear();
+  auto evaluate_bounded(std::false_type) -> void {}
+  auto evaluate_bounded(std::true_type) -> void
+  {
+    if (bounded_.empty())
+      return;
 
-    sort_population();
+    auto& problem = this->problem();
+    for (const auto i : improve_indexes_)
+      if (bounded_[i])
+      {
+        next_fitness_[i] = problem.evaluate(
+          const_cast<const individual_type&>(next_population_[i]), generator_);
+        --avoided_evaluations_;
+      }
   }
 
-  auto population() const noexcept -> const std::vector<solution_type>&
+  // == Memetic Improvement ==
+  // Selected solutions are improved in parallel.  Each one gets its own engine seeded
+  // from the main one, so results don't depend on the number of threads.
+  auto improve_offspring(std::false_type) -> void {}
+  auto improve_offspring(std::true_type) -> void
   {
-    return population_;
+    if (improvement_discarded())
+      return;
+
+    select_for_improvement(next_population_.size(), improvement_.offspring_rate);
+    evaluate_bounded(meta::StagedEvaluation<T>{});
+    detail::parallel_for(improve_indexes_.size(), improvement_.thread_count,
+                         [this](std::size_t k) {
+                           const auto i = improve_indexes_[k];
+                           improve(next_population_[i], next_fitness_[i],
+                                   improve_seeds_[k]);
+                         });
+
+    // The improved fitness is not a sample of `evaluate`.
+    for (const auto i : improve_indexes_)
+      reset_samples(elite_count_ + i, meta::NoisyEvaluation<T>{});
   }
 
-  auto problem() noexcept -> T& { return static_cast<T&>(problem_); }
-  auto problem() const noexcept -> const T& { return static_cast<const T&>(problem_); }
+  auto improve_elite(std::false_type) -> void {}
+  auto improve_elite(std::true_type) -> void
+  {
+    // Under Baldwinian write-back, an elite's fitness is no longer the fitness of its
+    // individual, so it's evaluated again to be the starting point of another
+    // improvement.  That requires single evaluation.
+    const auto baldwinian = improvement_.mode == write_back::baldwinian;
+    if ((baldwinian && !meta::SingleEvaluation<T>::value) || improvement_discarded())
+      return;
+
+    select_for_improvement(elite_count_, improvement_.elite_rate);
+    if (improve_indexes_.empty())
+      return;
+
+    if (baldwinian)
+      evaluate_elite(meta::SingleEvaluation<T>{});
+
+    detail::parallel_for(improve_indexes_.size(), improvement_.thread_count,
+                         [this](std::size_t k) {
+                           auto& s = population_[improve_indexes_[k]];
+                           improve(s.x, s.fitness, improve_seeds_[k]);
+                         });
+
+    // An improved elite is a new solution as far as fitness samples are concerned.
+    for (const auto i : improve_indexes_)
+      reset_samples(i, meta::NoisyEvaluation<T>{});
+  }
 
-  auto generator() noexcept -> generator_type& { return generator_; }
-  auto generator() const noexcept -> const generator_type& { return generator_; }
+  auto evaluate_elite(std::false_type) -> void {}
+  auto evaluate_elite(std::true_type) -> void
+  {
+    auto& problem = this->problem();
+    for (const auto i : improve_indexes_)
+    {
+      auto& s = population_[i];
+      s.fitness = problem.evaluate(const_cast<const individual_type&>(s.x), generator_);
+    }
+  }
 
-  auto elite_count() noexcept -> std::size_t& { return elite_count_; }
-  auto elite_count() const noexcept -> std::size_t { return elite_count_; }
+  // Under Baldwinian write-back only the improved fitness is kept, but resampling
+  // replaces it with evaluations of the unchanged individual, so improvement is skipped.
+  auto improvement_discarded() const noexcept -> bool
+  {
+    return improvement_.mode == write_back::baldwinian && resampling_.max_samples > 1u;
+  }
 
-private:
-  auto sort_population() -> void
+  auto select_for_improvement(std::size_t count, double rate) -> void
   {
-    std::partial_sort(population_.begin(), population_.begin() + elite_count_,
-                      population_.end(),
-                      [](const solution_type& a, const solution_type& b) {
-                        return a.fitness < b.fitness;
-                      });
+    improve_indexes_.clear();
+    improve_seeds_.clear();
+
+    if (rate <= 0.0)
+      return;
+
+    for (std::size_t i = 0u; i < count; ++i)
+      if (draw(rate, generator_))
+      {
+        improve_indexes_.push_back(i);
+        improve_seeds_.push_back(generator_());
+      }
+  }
+
+  auto improve(individual_type& x, fitness_type& fitness,
+               typename generator_type::result_type seed) -> void
+  {
+    auto g = generator_type(seed);
+
+    if (improvement_.mode == write_back::baldwinian)
+    {
+      auto copy = x;
+      improve_steps(copy, fitness, g);
+    }
+    else
+    {
+      improve_steps(x, fitness, g);
+    }
+  }
+
+  auto improve_steps(individual_type& x, fitness_type& fitness, generator_type& g) -> void
+  {
+    using clock = std::chrono::steady_clock;
+
+    auto& problem = this->problem();
+    const auto limited = improvement_.time_budget > clock::duration::zero();
+    const auto start = limited ? clock::now() : clock::time_point{};
+
+    for (std::size_t step = 0u; step < improvement_.step_budget; ++step)
+    {
+      problem.improve(x, fitness, g);
+      if (limited && clock::now() - start >= improvement_.time_budget)
+        break;
+    }
   }
 
   template <typename Distribution>
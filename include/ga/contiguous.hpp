@@ -0,0 +1,64 @@
+// Copyright (c) 2018 Filipe Verri <filipeverri@gmail.com>
+
+#ifndef GA_CONTIGUOUS_HPP
+#define GA_CONTIGUOUS_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Helpers for operators over genomes with contiguous storage.
+
+namespace ga
+{
+namespace detail
+{
+namespace contiguous_adl
+{
+using std::begin;
+using std::end;
+
+template <typename C>
+using value_type = typename std::decay<decltype(*begin(std::declval<C&>()))>::type;
+
+template <typename C> auto data(C& c) -> decltype(std::addressof(*begin(c)))
+{
+  return std::addressof(*begin(c));
+}
+
+template <typename C> auto length(const C& c) -> std::size_t
+{
+  return static_cast<std::size_t>(std::distance(begin(c), end(c)));
+}
+} // namespace contiguous_adl
+
+using contiguous_adl::data;
+using contiguous_adl::length;
+using contiguous_adl::value_type;
+
+template <typename C> auto check_sizes(const C& a, const C& b) -> std::size_t
+{
+  const auto n = length(a);
+  if (n != length(b))
+    throw std::invalid_argument{"parents have different sizes"};
+  return n;
+}
+
+// Per-thread reusable buffer.  The `Tag` allows one operator to hold several
+// independent buffers of the same value type.  The buffer only grows, so after the
+// first few calls no allocation happens.
+template <typename T, typename Tag = void> auto scratch(std::size_t size) -> T*
+{
+  static thread_local std::vector<T> buffer;
+  if (buffer.size() < size)
+    buffer.resize(size);
+  return buffer.data();
+}
+
+} // namespace detail
+} // namespace ga
+
+#endif // GA_CONTIGUOUS_HPP
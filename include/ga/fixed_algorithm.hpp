@@ -0,0 +1,154 @@
+// Copyright (c) 2017-2018 Filipe Verri <filipeverri@gmail.com>
+
+#ifndef GA_FIXED_ALGORITHM_HPP
+#define GA_FIXED_ALGORITHM_HPP
+
+#include <ga/algorithm.hpp>
+#include <ga/meta.hpp>
+#include <ga/type.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <type_traits>
+
+namespace ga
+{
+
+// Same algorithm as `ga::algorithm`, but population size and elite count are known at
+// compile time.  Every buffer is a `std::array`, so `iterate()` performs no allocation
+// (besides the ones the user-defined problem may perform) and no size validation.
+//
+// Since fitness values are written straight into the population, only problems with
+// single evaluation are supported.  Individuals and fitness must be
+// default-constructible.
+template <typename T, std::size_t N, std::size_t E, typename = void> class fixed_algorithm
+{
+  static_assert(meta::always_false<T>::value,
+                "Problem type doesn't comply with the required concept");
+};
+
+template <typename T, std::size_t N, std::size_t E>
+class fixed_algorithm<T, N, E,
+                      meta::requires<meta::Problem<T>, meta::SingleEvaluation<T>>>
+{
+  static_assert(E < N, "invalid elite_count");
+
+public:
+  using individual_type = typename T::individual_type;
+  using generator_type = typename T::generator_type;
+  using fitness_type = typename T::fitness_type;
+  using solution_type = solution<individual_type, fitness_type>;
+
+  static constexpr std::size_t population_size = N;
+  static constexpr std::size_t offspring_size = N - E;
+
+private:
+  T problem_;
+  std::array<solution_type, N> population_;
+  std::array<individual_type, N - E> next_population_;
+  generator_type generator_;
+
+public:
+  fixed_algorithm(T problem, std::array<individual_type, N> population,
+                  generator_type generator)
+    : problem_(std::move(problem))
+    , generator_(std::move(generator))
+  {
+    for (std::size_t i = 0u; i < N; ++i)
+    {
+      population_[i].fitness = problem_.evaluate(
+        const_cast<const individual_type&>(population[i]), generator_);
+      population_[i].x = std::move(population[i]);
+    }
+
+    sort_population();
+  }
+
+  auto iterate() -> void
+  {
+    // == Mating Selection, Recombination and Mutation ==
+    // We perform binary tournament selection with replacement.
+    auto indexes = std::uniform_int_distribution<std::size_t>(0u, N - 1u);
+
+    const auto binary_tournament = [&]() -> const individual_type& {
+      const auto i = indexes(generator_);
+      const auto j = indexes(generator_);
+      return population_[i].fitness < population_[j].fitness ? population_[i].x
+                                                             : population_[j].x;
+    };
+
+    std::size_t count = 0u;
+    while (count < N - E)
+    {
+      const auto& parent1 = binary_tournament();
+      const auto& parent2 = binary_tournament();
+
+      auto children = problem_.recombine(parent1, parent2, generator_);
+
+      for (auto& child : children)
+      {
+        problem_.mutate(child, generator_);
+        next_population_[count++] = std::move(child);
+        if (count == N - E)
+          break;
+      }
+    }
+
+    // == Evaluation and Replacement ==
+    // Children replace every non-elite solution.
+    for (std::size_t i = 0u; i < N - E; ++i)
+    {
+      auto& target = population_[E + i];
+      target.fitness = problem_.evaluate(
+        const_cast<const individual_type&>(next_population_[i]), generator_);
+      target.x = std::move(next_population_[i]);
+    }
+
+    sort_population();
+  }
+
+  auto population() const noexcept -> const std::array<solution_type, N>&
+  {
+    return population_;
+  }
+
+  auto problem() noexcept -> T& { return problem_; }
+  auto problem() const noexcept -> const T& { return problem_; }
+
+  auto generator() noexcept -> generator_type& { return generator_; }
+  auto generator() const noexcept -> const generator_type& { return generator_; }
+
+  static constexpr auto elite_count() noexcept -> std::size_t { return E; }
+
+private:
+  auto sort_population() -> void
+  {
+    std::partial_sort(population_.begin(), population_.begin() + E, population_.end(),
+                      [](const solution_type& a, const solution_type& b) {
+                        return a.fitness < b.fitness;
+                      });
+  }
+};
+
+template <typename T, std::size_t N, std::size_t E>
+constexpr std::size_t
+  fixed_algorithm<T, N, E, meta::requires<meta::Problem<T>, meta::SingleEvaluation<T>>>::
+    population_size;
+
+template <typename T, std::size_t N, std::size_t E>
+constexpr std::size_t
+  fixed_algorithm<T, N, E, meta::requires<meta::Problem<T>, meta::SingleEvaluation<T>>>::
+    offspring_size;
+
+template <std::size_t E, typename T, typename I, std::size_t N, typename G,
+          typename = meta::requires<meta::Problem<T>, meta::SingleEvaluation<T>>>
+auto make_fixed_algorithm(T problem, std::array<I, N> population, G generator)
+  -> fixed_algorithm<T, N, E>
+{
+  return {std::move(problem), std::move(population), std::move(generator)};
+}
+
+} // namespace ga
+
+#endif // GA_FIXED_ALGORITHM_HPP
@@ -0,0 +1,484 @@
+// Copyright (c) 2018 Filipe Verri <filipeverri@gmail.com>
+
+#ifndef GA_MAPPED_ALGORITHM_HPP
+#define GA_MAPPED_ALGORITHM_HPP
+
+#include <ga/algorithm.hpp>
+#include <ga/meta.hpp>
+#include <ga/type.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Genetic algorithm for populations that don't fit in memory (POSIX only).
+//
+// Individuals are stored in two memory-mapped temporary files, one for the current
+// population and one for the next.  Only fitness values and indexes are kept in RAM.
+// Offspring are bred, written, and evaluated in chunks; after each chunk, the pages of
+// both mappings are released, so resident memory is bounded by the chunk size rather
+// than by the population size.  Parents are selected at random, so they are read with
+// `pread` instead: touching them through the mapping would map whole page-cache folios
+// around each of them.
+
+namespace ga
+{
+
+// Storage settings of `ga::mapped_algorithm`.  Temporary files are created (and
+// immediately unlinked) in `directory`, which defaults to `$TMPDIR` or, if unset, to
+// `/var/tmp`.  The directory must be on a disk-backed file system: on a tmpfs (as `/tmp`
+// often is), the files are kept in memory anyway.  Offspring are processed in chunks of
+// about `chunk_bytes` bytes.
+struct mapped_options
+{
+  std::string directory;
+  std::size_t chunk_bytes = std::size_t{64u} << 20u;
+};
+
+namespace detail
+{
+
+inline auto temporary_directory(const std::string& directory) -> std::string
+{
+  if (!directory.empty())
+    return directory;
+
+  const auto tmpdir = std::getenv("TMPDIR");
+  return tmpdir && *tmpdir ? tmpdir : "/var/tmp";
+}
+
+class mapped_file
+{
+public:
+  mapped_file() = default;
+
+  mapped_file(const std::string& directory, std::size_t size)
+  {
+    const auto root = temporary_directory(directory);
+    auto path = std::vector<char>(root.begin(), root.end());
+    const auto name = std::string{"/ga-XXXXXX"};
+    path.insert(path.end(), name.begin(), name.end());
+    path.push_back('\0');
+
+    const auto fd = ::mkstemp(path.data());
+    if (fd == -1)
+      throw std::system_error{errno, std::generic_category(), "mkstemp"};
+
+    ::unlink(path.data());
+
+    if (::ftruncate(fd, static_cast<off_t>(size)) == -1)
+    {
+      const auto error = errno;
+      ::close(fd);
+      throw std::system_error{error, std::generic_category(), "ftruncate"};
+    }
+
+    const auto address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED)
+    {
+      const auto error = errno;
+      ::close(fd);
+      throw std::system_error{error, std::generic_category(), "mmap"};
+    }
+
+    fd_ = fd;
+    data_ = static_cast<unsigned char*>(address);
+    size_ = size;
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  auto operator=(const mapped_file&) -> mapped_file& = delete;
+
+  mapped_file(mapped_file&& other) noexcept
+    : fd_{other.fd_}
+    , data_{other.data_}
+    , size_{other.size_}
+  {
+    other.fd_ = -1;
+    other.data_ = nullptr;
+    other.size_ = 0u;
+  }
+
+  auto operator=(mapped_file&& other) noexcept -> mapped_file&
+  {
+    std::swap(fd_, other.fd_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+
+  ~mapped_file()
+  {
+    if (data_)
+      ::munmap(data_, size_);
+    if (fd_ != -1)
+      ::close(fd_);
+  }
+
+  auto data() const noexcept -> unsigned char* { return data_; }
+  auto size() const noexcept -> std::size_t { return size_; }
+
+  // Applies `advice` to the pages entirely within `[first, last)` bytes.  Advice is a
+  // hint, so failures are ignored.
+  auto advise(std::size_t first, std::size_t last, int advice) const noexcept -> void
+  {
+    static const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+
+    first = (first + page - 1u) / page * page;
+    last = std::min(last, size_) / page * page;
+    if (first < last)
+      ::madvise(data_ + first, last - first, advice);
+  }
+
+  auto advise(int advice) const noexcept -> void { advise(0u, size_, advice); }
+
+  // Copies `[offset, offset + size)` bytes of the file without mapping them.
+  auto read(std::size_t offset, void* out, std::size_t size) const -> void
+  {
+    auto buffer = static_cast<unsigned char*>(out);
+    while (size > 0u)
+    {
+      const auto n = ::pread(fd_, buffer, size, static_cast<off_t>(offset));
+      if (n == -1 && errno == EINTR)
+        continue;
+      if (n <= 0)
+        throw std::system_error{n == 0 ? EIO : errno, std::generic_category(), "pread"};
+
+      const auto count = static_cast<std::size_t>(n);
+      buffer += count;
+      offset += count;
+      size -= count;
+    }
+  }
+
+private:
+  int fd_ = -1;
+  unsigned char* data_ = nullptr;
+  std::size_t size_ = 0u;
+};
+
+} // namespace detail
+
+template <typename T, typename E = void> class mapped_algorithm
+{
+  static_assert(meta::always_false<T>::value,
+                "Problem type doesn't comply with the required concept");
+};
+
+template <typename T>
+class mapped_algorithm<
+  T, meta::requires<meta::Problem<T>, meta::SingleEvaluation<T>,
+                    std::is_trivially_copyable<typename T::individual_type>,
+                    std::is_default_constructible<typename T::individual_type>>>
+{
+public:
+  using individual_type = typename T::individual_type;
+  using generator_type = typename T::generator_type;
+  using fitness_type = typename T::fitness_type;
+  using solution_type = solution<individual_type, fitness_type>;
+
+private:
+  T problem_;
+  std::size_t size_;
+  std::size_t elite_count_;
+  std::size_t chunk_size_;
+  generator_type generator_;
+
+  detail::mapped_file current_, next_;
+  std::vector<fitness_type> fitness_, next_fitness_;
+  std::vector<std::size_t> elite_indexes_;
+  std::vector<fitness_type> elite_fitness_;
+  std::vector<bool> losers_;
+
+public:
+  // The initial population is generated by `initializer(generator_type&)`, which must
+  // return an individual.
+  template <typename F>
+  mapped_algorithm(T problem, std::size_t population_size, std::size_t elite_count,
+                   F initializer, generator_type generator,
+                   const mapped_options& options = mapped_options{})
+    : problem_(std::move(problem))
+    , size_(checked_size(population_size, elite_count))
+    , elite_count_(elite_count)
+    , chunk_size_(
+        std::max<std::size_t>(options.chunk_bytes / sizeof(individual_type), 1u))
+    , generator_(std::move(generator))
+    , current_(options.directory, file_size(population_size))
+    , next_(options.directory, file_size(population_size))
+    , fitness_(population_size)
+    , next_fitness_(population_size)
+  {
+    elite_indexes_.reserve(elite_count_);
+    elite_fitness_.resize(elite_count_);
+    losers_.reserve(elite_count_);
+
+    // Individuals are generated into the next buffer and then copied, elites first,
+    // into the current one.
+    next_.advise(MADV_SEQUENTIAL);
+    for (std::size_t first = 0u; first < size_; first += chunk_size_)
+    {
+      const auto last = std::min(first + chunk_size_, size_);
+      for (auto i = first; i < last; ++i)
+      {
+        const individual_type x = initializer(generator_);
+        store(next_, i, x);
+        next_fitness_[i] = problem_.evaluate(x, generator_);
+      }
+      next_.advise(first * sizeof(individual_type), last * sizeof(individual_type),
+                   MADV_DONTNEED);
+    }
+
+    select_elite(next_fitness_);
+
+    auto is_elite = std::vector<bool>(size_, false);
+    for (std::size_t r = 0u; r < elite_count_; ++r)
+    {
+      const auto i = elite_indexes_[r];
+      is_elite[i] = true;
+      copy(next_, i, current_, r);
+      fitness_[r] = next_fitness_[i];
+    }
+
+    current_.advise(MADV_SEQUENTIAL);
+    auto k = elite_count_;
+    for (std::size_t i = 0u; i < size_; ++i)
+    {
+      if (is_elite[i])
+        continue;
+      copy(next_, i, current_, k);
+      fitness_[k++] = next_fitness_[i];
+
+      if (k % chunk_size_ == 0u)
+        release();
+    }
+    release();
+  }
+
+  auto iterate() -> void
+  {
+    // == Mating Selection, Recombination and Mutation ==
+    // Same as `ga::algorithm`, but children are written straight to the next buffer and
+    // evaluated one chunk at a time.
+    next_.advise(MADV_SEQUENTIAL);
+
+    auto indexes = std::uniform_int_distribution<std::size_t>(0u, size_ - 1u);
+
+    const auto binary_tournament = [&](individual_type& parent) {
+      const auto i = indexes(generator_);
+      const auto j = indexes(generator_);
+      load(current_, fitness_[i] < fitness_[j] ? i : j, parent);
+    };
+
+    individual_type parent1, parent2;
+
+    auto count = elite_count_;
+    auto chunk_begin = count;
+    while (count < size_)
+    {
+      binary_tournament(parent1);
+      binary_tournament(parent2);
+
+      auto children = problem_.recombine(parent1, parent2, generator_);
+
+      for (auto& child : children)
+      {
+        problem_.mutate(child, generator_);
+        store(next_, count++, child);
+        if (count == size_)
+          break;
+      }
+
+      if (count - chunk_begin >= chunk_size_ || count == size_)
+      {
+        evaluate_chunk(chunk_begin, count);
+        chunk_begin = count;
+      }
+    }
+
+    // == Replacement ==
+    // Old elites (in the current buffer) and children (in the next one) compete for the
+    // elite slots.  The losers among old elites take the slots of the winning children.
+    for (std::size_t i = 0u; i < elite_count_; ++i)
+      next_fitness_[i] = fitness_[i];
+
+    select_elite(next_fitness_);
+
+    losers_.assign(elite_count_, true);
+    for (const auto i : elite_indexes_)
+      if (i < elite_count_)
+        losers_[i] = false;
+
+    auto loser = std::size_t{0u};
+    for (std::size_t r = 0u; r < elite_count_; ++r)
+    {
+      const auto i = elite_indexes_[r];
+      if (i < elite_count_)
+        continue;
+
+      copy(next_, i, next_, r);
+      elite_fitness_[r] = next_fitness_[i];
+
+      while (!losers_[loser])
+        ++loser;
+      copy(current_, loser, next_, i);
+      next_fitness_[i] = next_fitness_[loser++];
+    }
+
+    for (std::size_t r = 0u; r < elite_count_; ++r)
+    {
+      const auto i = elite_indexes_[r];
+      if (i < elite_count_)
+      {
+        copy(current_, i, next_, r);
+        elite_fitness_[r] = next_fitness_[i];
+      }
+    }
+
+    std::copy(elite_fitness_.begin(), elite_fitness_.end(), next_fitness_.begin());
+
+    std::swap(current_, next_);
+    fitness_.swap(next_fitness_);
+
+    release();
+  }
+
+  auto size() const noexcept -> std::size_t { return size_; }
+
+  // The first `elite_count()` individuals are the best ones, sorted by fitness.  The
+  // returned reference is valid until the next call to `iterate()`.
+  auto individual(std::size_t i) const noexcept -> const individual_type&
+  {
+    return *reinterpret_cast<const individual_type*>(current_.data() +
+                                                     i * sizeof(individual_type));
+  }
+
+  auto fitness() const noexcept -> const std::vector<fitness_type>& { return fitness_; }
+
+  auto at(std::size_t i) const -> solution_type
+  {
+    return {individual(i), fitness_[i]};
+  }
+
+  auto problem() noexcept -> T& { return problem_; }
+  auto problem() const noexcept -> const T& { return problem_; }
+
+  auto generator() noexcept -> generator_type& { return generator_; }
+  auto generator() const noexcept -> const generator_type& { return generator_; }
+
+  auto elite_count() const noexcept -> std::size_t { return elite_count_; }
+
+private:
+  // Sizes are validated before any file or buffer is created.
+  static auto checked_size(std::size_t population_size, std::size_t elite_count)
+    -> std::size_t
+  {
+    if (elite_count >= population_size)
+      throw std::invalid_argument{"invalid elite_count"};
+    return population_size;
+  }
+
+  static auto file_size(std::size_t population_size) -> std::size_t
+  {
+    const auto max_size = std::min<std::uintmax_t>(
+      std::numeric_limits<std::size_t>::max(), std::numeric_limits<off_t>::max());
+    if (population_size > max_size / sizeof(individual_type))
+      throw std::invalid_argument{"invalid population_size"};
+    return population_size * sizeof(individual_type);
+  }
+
+  static auto store(const detail::mapped_file& file, std::size_t i,
+                    const individual_type& x) -> void
+  {
+    std::memcpy(file.data() + i * sizeof(individual_type), std::addressof(x),
+                sizeof(individual_type));
+  }
+
+  static auto load(const detail::mapped_file& file, std::size_t i, individual_type& x)
+    -> void
+  {
+    file.read(i * sizeof(individual_type), std::addressof(x), sizeof(individual_type));
+  }
+
+  static auto copy(const detail::mapped_file& from, std::size_t i,
+                   const detail::mapped_file& to, std::size_t j) -> void
+  {
+    std::memcpy(to.data() + j * sizeof(individual_type),
+                from.data() + i * sizeof(individual_type), sizeof(individual_type));
+  }
+
+  auto evaluate_chunk(std::size_t first, std::size_t last) -> void
+  {
+    for (auto i = first; i < last; ++i)
+    {
+      const auto& x = *reinterpret_cast<const individual_type*>(
+        next_.data() + i * sizeof(individual_type));
+      next_fitness_[i] = problem_.evaluate(x, generator_);
+    }
+
+    next_.advise(first * sizeof(individual_type), last * sizeof(individual_type),
+                 MADV_DONTNEED);
+  }
+
+  // Drops every mapped page from memory.  The contents stay in the files.
+  auto release() -> void
+  {
+    current_.advise(MADV_DONTNEED);
+    next_.advise(MADV_DONTNEED);
+  }
+
+  // Indexes of the `elite_count_` best values of `fitness`, sorted.  Uses a bounded heap,
+  // so extra memory doesn't grow with the population size.
+  auto select_elite(const std::vector<fitness_type>& fitness) -> void
+  {
+    const auto by_fitness = [&](std::size_t i, std::size_t j) {
+      return fitness[i] < fitness[j];
+    };
+
+    elite_indexes_.clear();
+    for (std::size_t i = 0u; i < size_; ++i)
+    {
+      if (elite_indexes_.size() < elite_count_)
+      {
+        elite_indexes_.push_back(i);
+        std::push_heap(elite_indexes_.begin(), elite_indexes_.end(), by_fitness);
+      }
+      else if (elite_count_ > 0u && by_fitness(i, elite_indexes_.front()))
+      {
+        std::pop_heap(elite_indexes_.begin(), elite_indexes_.end(), by_fitness);
+        elite_indexes_.back() = i;
+        std::push_heap(elite_indexes_.begin(), elite_indexes_.end(), by_fitness);
+      }
+    }
+
+    std::sort_heap(elite_indexes_.begin(), elite_indexes_.end(), by_fitness);
+  }
+};
+
+template <typename T, typename F, typename G,
+          typename = meta::requires<meta::Problem<T>, meta::SingleEvaluation<T>>>
+auto make_mapped_algorithm(T problem, std::size_t population_size,
+                           std::size_t elite_count, F initializer, G generator,
+                           const mapped_options& options = mapped_options{})
+  -> mapped_algorithm<T>
+{
+  return {std::move(problem), population_size, elite_count, std::move(initializer),
+          std::move(generator), options};
+}
+
+} // namespace ga
+
+#endif // GA_MAPPED_ALGORITHM_HPP
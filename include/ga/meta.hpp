@@ -6,6 +6,8 @@
 #include <ga/type.hpp>
 
 #include <array>
+#include <cstddef>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -127,6 +129,23 @@ using recombine_result = decltype(
 
 template <typename T> using has_recombine = meta::compiles<T, recombine_result>;
 
+template <typename T>
+using tuple_size_result = decltype(std::tuple_size<typename std::decay<T>::type>::value);
+
+// Number of children returned by every call to `problem::recombine` when it's known at
+// compile time (e.g., `std::array`); zero otherwise.
+template <typename T, typename = void>
+struct RecombinationSize : std::integral_constant<std::size_t, 0u>
+{
+};
+
+template <typename T>
+struct RecombinationSize<T, requires<compiles<recombine_result<T>, tuple_size_result>>>
+  : std::integral_constant<
+      std::size_t, std::tuple_size<typename std::decay<recombine_result<T>>::type>::value>
+{
+};
+
 template <typename T>
 using evaluate_result =
   decltype(std::declval<T&>().evaluate(std::declval<const typename T::individual_type&>(),
@@ -169,6 +188,57 @@ struct MultiEvaluation<
 {
 };
 
+template <typename T>
+using improve_result =
+  decltype(std::declval<T&>().improve(std::declval<typename T::individual_type&>(),
+                                      std::declval<typename T::fitness_type&>(),
+                                      std::declval<typename T::generator_type&>()));
+
+template <typename T> using has_improve = meta::compiles<T, improve_result>;
+
+template <typename T, typename = void> struct Improvement : std::false_type
+{
+};
+
+template <typename T>
+struct Improvement<
+  T, requires<conjunction<has_improve<T>, std::is_same<void, improve_result<T>>>>>
+  : std::true_type
+{
+};
+
+template <typename T>
+using bound_result =
+  decltype(std::declval<T&>().bound(std::declval<const typename T::individual_type&>(),
+                                    std::declval<typename T::generator_type&>()));
+
+template <typename T> using has_bound = meta::compiles<T, bound_result>;
+
+// Problems with a cheap lower bound on the fitness of an individual.
+template <typename T, typename = void> struct StagedEvaluation : std::false_type
+{
+};
+
+template <typename T>
+struct StagedEvaluation<
+  T, requires<SingleEvaluation<T>, has_bound<T>,
+              std::is_same<typename T::fitness_type, bound_result<T>>>> : std::true_type
+{
+};
+
+// Problems whose individuals can be evaluated again and whose fitness samples can be
+// averaged.
+template <typename T, typename = void> struct NoisyEvaluation : std::false_type
+{
+};
+
+template <typename T>
+struct NoisyEvaluation<
+  T, requires<SingleEvaluation<T>, std::is_floating_point<typename T::fitness_type>>>
+  : std::true_type
+{
+};
+
 template <typename T, typename = void> struct Problem : std::false_type
 {
 };
@@ -0,0 +1,246 @@
+// Copyright (c) 2018 Filipe Verri <filipeverri@gmail.com>
+
+#ifndef GA_PARALLEL_HPP
+#define GA_PARALLEL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace ga
+{
+namespace detail
+{
+
+// Pins the calling thread, the `k`-th of `n`, to one of the cores it is allowed to run
+// on.  Threads are spread evenly over the allowed cores (wrapping around if there are
+// more threads than cores), so a few threads don't crowd onto the first socket.  Pinning
+// is a hint, so it does nothing where unsupported.
+inline auto pin_to_core(std::size_t k, std::size_t n) -> void
+{
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    return;
+
+  const auto count = static_cast<std::size_t>(CPU_COUNT(&allowed));
+  if (count == 0u || n == 0u)
+    return;
+
+  auto target = n <= count ? k * count / n : k % count;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (!CPU_ISSET(cpu, &allowed) || target-- > 0u)
+      continue;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+    return;
+  }
+#else
+  (void)k;
+  (void)n;
+#endif
+}
+
+// Calls `f(i)` for every `i` in `[0, count)` using up to `thread_count` threads.  Indexes
+// are split in contiguous chunks, one per thread, and the calling thread takes the
+// first one.  The first exception thrown by any chunk is rethrown after every thread has
+// finished.
+template <typename F>
+auto parallel_for(std::size_t count, std::size_t thread_count, F&& f) -> void
+{
+  thread_count = std::max<std::size_t>(1u, std::min(thread_count, count));
+
+  if (thread_count == 1u)
+  {
+    for (std::size_t i = 0u; i < count; ++i)
+      f(i);
+    return;
+  }
+
+  auto errors = std::vector<std::exception_ptr>(thread_count);
+
+  const auto chunk = [&](std::size_t k) {
+    try
+    {
+      const auto last = count * (k + 1u) / thread_count;
+      for (auto i = count * k / thread_count; i < last; ++i)
+        f(i);
+    }
+    catch (...)
+    {
+      errors[k] = std::current_exception();
+    }
+  };
+
+  auto workers = std::vector<std::thread>();
+  workers.reserve(thread_count - 1u);
+  for (auto k = 1u; k < thread_count; ++k)
+    workers.emplace_back(chunk, k);
+
+  chunk(0u);
+
+  for (auto& worker : workers)
+    worker.join();
+
+  for (const auto& error : errors)
+    if (error)
+      std::rethrow_exception(error);
+}
+
+// Threads kept alive across calls to `run`, which works like `parallel_for` except that
+// every chunk runs on a worker and the calling thread only waits.  Workers are started on
+// first use and restarted only when the number of threads or the pinning changes; pinned
+// workers are spread with `pin_to_core` once, when started.  Copies start without
+// workers of their own.
+class worker_pool
+{
+public:
+  worker_pool() = default;
+  worker_pool(const worker_pool&) {}
+  worker_pool(worker_pool&&) noexcept = default;
+  ~worker_pool() { stop(); }
+
+  auto operator=(const worker_pool&) -> worker_pool& { return *this; }
+  auto operator=(worker_pool&& other) noexcept -> worker_pool&
+  {
+    stop();
+    state_ = std::move(other.state_);
+    return *this;
+  }
+
+  template <typename F>
+  auto run(std::size_t count, std::size_t thread_count, F&& f, bool pin = false) -> void
+  {
+    thread_count = std::max<std::size_t>(1u, std::min(thread_count, count));
+
+    if (thread_count == 1u && !pin)
+    {
+      for (std::size_t i = 0u; i < count; ++i)
+        f(i);
+      return;
+    }
+
+    if (!state_ || state_->workers.size() != thread_count || state_->pinned != pin)
+      start(thread_count, pin);
+
+    auto errors = std::vector<std::exception_ptr>(thread_count);
+
+    {
+      std::lock_guard<std::mutex> lock{state_->mutex};
+      state_->task = [&](std::size_t k) {
+        try
+        {
+          const auto last = count * (k + 1u) / thread_count;
+          for (auto i = count * k / thread_count; i < last; ++i)
+            f(i);
+        }
+        catch (...)
+        {
+          errors[k] = std::current_exception();
+        }
+      };
+      state_->pending = thread_count;
+      ++state_->generation;
+    }
+    state_->wake.notify_all();
+
+    {
+      std::unique_lock<std::mutex> lock{state_->mutex};
+      state_->done.wait(lock, [this] { return state_->pending == 0u; });
+      state_->task = nullptr;
+    }
+
+    for (const auto& error : errors)
+      if (error)
+        std::rethrow_exception(error);
+  }
+
+private:
+  struct state
+  {
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::function<void(std::size_t)> task;
+    std::size_t generation = 0u;
+    std::size_t pending = 0u;
+    bool stopping = false;
+    bool pinned = false;
+    std::vector<std::thread> workers;
+  };
+
+  auto start(std::size_t thread_count, bool pin) -> void
+  {
+    stop();
+    state_.reset(new state);
+    state_->pinned = pin;
+
+    // Workers only touch the state through this pointer, which outlives them.
+    auto* shared = state_.get();
+    shared->workers.reserve(thread_count);
+    for (std::size_t k = 0u; k < thread_count; ++k)
+    {
+      shared->workers.emplace_back([shared, k, thread_count, pin] {
+        if (pin)
+          pin_to_core(k, thread_count);
+
+        auto seen = std::size_t{0u};
+        for (;;)
+        {
+          std::unique_lock<std::mutex> lock{shared->mutex};
+          shared->wake.wait(
+            lock, [&] { return shared->stopping || shared->generation != seen; });
+          if (shared->stopping)
+            return;
+          seen = shared->generation;
+
+          lock.unlock();
+          shared->task(k);
+          lock.lock();
+
+          if (--shared->pending == 0u)
+            shared->done.notify_one();
+        }
+      });
+    }
+  }
+
+  auto stop() -> void
+  {
+    if (!state_)
+      return;
+
+    {
+      std::lock_guard<std::mutex> lock{state_->mutex};
+      state_->stopping = true;
+    }
+    state_->wake.notify_all();
+
+    for (auto& worker : state_->workers)
+      worker.join();
+    state_.reset();
+  }
+
+  std::unique_ptr<state> state_;
+};
+
+} // namespace detail
+} // namespace ga
+
+#endif // GA_PARALLEL_HPP
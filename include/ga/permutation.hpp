@@ -0,0 +1,353 @@
+// Copyright (c) 2018 Filipe Verri <filipeverri@gmail.com>
+
+#ifndef GA_PERMUTATION_HPP
+#define GA_PERMUTATION_HPP
+
+#include <ga/contiguous.hpp>
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <random>
+#include <type_traits>
+#include <utility>
+
+// Operators for permutation genomes.
+//
+// Genomes are any container with contiguous storage of integral values that is a
+// permutation of `0, 1, ..., n - 1`, e.g., `std::vector<int>` or
+// `std::array<std::size_t, N>`.  Every operator runs in O(n) time.  Lookup tables are
+// kept in per-thread scratch buffers which are reused across calls, so the only
+// allocations are the copies of the parents returned as children.
+//
+// Crossover operators return two children and mutation operators change the individual
+// in-place, so they can be forwarded by `problem::recombine` and `problem::mutate`.
+
+namespace ga
+{
+namespace permutation
+{
+namespace detail
+{
+using ::ga::detail::check_sizes;
+using ::ga::detail::data;
+using ::ga::detail::length;
+using ::ga::detail::scratch;
+using ::ga::detail::value_type;
+
+template <int> struct buffer;
+
+template <typename T> auto index(T value) -> std::size_t
+{
+  return static_cast<std::size_t>(value);
+}
+
+// Random cut points `a <= b` defining the segment `[a, b)`.
+template <typename G>
+auto segment(std::size_t n, G& g) -> std::pair<std::size_t, std::size_t>
+{
+  auto dist = std::uniform_int_distribution<std::size_t>(0u, n);
+  auto a = dist(g);
+  auto b = dist(g);
+  if (a > b)
+    std::swap(a, b);
+  return {a, b};
+}
+
+// Child keeps `donor[a, b)` in place and the remaining positions, starting from `b`, are
+// filled with the missing genes in the order they appear in `other` (also from `b`).
+template <typename T>
+auto order_child(const T* donor, const T* other, T* child, std::size_t n, std::size_t a,
+                 std::size_t b) -> void
+{
+  const auto used = scratch<unsigned char, buffer<0>>(n);
+  std::fill(used, used + n, 0u);
+
+  for (auto i = a; i < b; ++i)
+  {
+    child[i] = donor[i];
+    used[index(donor[i])] = 1u;
+  }
+
+  auto k = b == n ? 0u : b;
+  auto j = k;
+  for (std::size_t t = 0u; t < n; ++t)
+  {
+    const auto v = other[j];
+    if (!used[index(v)])
+    {
+      child[k] = v;
+      if (++k == n)
+        k = 0u;
+    }
+    if (++j == n)
+      j = 0u;
+  }
+}
+
+// `child` must be a copy of `other`.  Each gene of `donor[a, b)` is moved into place by
+// swapping, which is equivalent to following the partial mapping.
+template <typename T>
+auto partially_mapped_child(const T* donor, T* child, std::size_t n, std::size_t a,
+                            std::size_t b) -> void
+{
+  const auto position = scratch<std::size_t, buffer<0>>(n);
+  for (std::size_t i = 0u; i < n; ++i)
+    position[index(child[i])] = i;
+
+  for (auto i = a; i < b; ++i)
+  {
+    const auto v = donor[i];
+    const auto j = position[index(v)];
+    if (j == i)
+      continue;
+
+    const auto w = child[i];
+    child[j] = w;
+    position[index(w)] = j;
+    child[i] = v;
+    position[index(v)] = i;
+  }
+}
+
+template <typename T, typename G>
+auto edge_child(const T* parent1, const T* parent2, T* child, std::size_t n,
+                std::size_t start, G& g) -> void
+{
+  static constexpr std::size_t max_degree = 4u;
+
+  const auto adjacency = scratch<std::size_t, buffer<0>>(max_degree * n);
+  const auto degree = scratch<std::size_t, buffer<1>>(n);
+  const auto remaining = scratch<std::size_t, buffer<2>>(n);
+  const auto where = scratch<std::size_t, buffer<3>>(n);
+
+  std::fill(degree, degree + n, 0u);
+
+  const auto add_edge = [&](std::size_t v, std::size_t u) {
+    const auto first = adjacency + max_degree * v;
+    const auto last = first + degree[v];
+    if (std::find(first, last, u) == last)
+      adjacency[max_degree * v + degree[v]++] = u;
+  };
+
+  for (const auto parent : {parent1, parent2})
+    for (std::size_t i = 0u; i < n; ++i)
+    {
+      const auto v = index(parent[i]);
+      add_edge(v, index(parent[i == 0u ? n - 1u : i - 1u]));
+      add_edge(v, index(parent[i + 1u == n ? 0u : i + 1u]));
+    }
+
+  for (std::size_t i = 0u; i < n; ++i)
+  {
+    remaining[i] = i;
+    where[i] = i;
+  }
+  auto remaining_count = n;
+
+  auto current = start;
+  for (std::size_t step = 0u; step < n; ++step)
+  {
+    child[step] = static_cast<T>(current);
+
+    // Remove `current` from the unvisited set and from its neighbors' lists.
+    {
+      const auto last = remaining[--remaining_count];
+      remaining[where[current]] = last;
+      where[last] = where[current];
+    }
+
+    for (std::size_t k = 0u; k < degree[current]; ++k)
+    {
+      const auto u = adjacency[max_degree * current + k];
+      const auto list = adjacency + max_degree * u;
+      const auto it = std::find(list, list + degree[u], current);
+      *it = list[--degree[u]];
+    }
+
+    if (remaining_count == 0u)
+      break;
+
+    // Prefer the neighbor with the fewest edges left, breaking ties at random.
+    // Otherwise, restart from a random unvisited node.
+    if (degree[current] == 0u)
+    {
+      auto dist = std::uniform_int_distribution<std::size_t>(0u, remaining_count - 1u);
+      current = remaining[dist(g)];
+      continue;
+    }
+
+    auto best = adjacency[max_degree * current];
+    auto ties = std::size_t{1u};
+    for (std::size_t k = 1u; k < degree[current]; ++k)
+    {
+      const auto u = adjacency[max_degree * current + k];
+      if (degree[u] < degree[best])
+      {
+        best = u;
+        ties = 1u;
+      }
+      else if (degree[u] == degree[best] &&
+               std::uniform_int_distribution<std::size_t>(0u, ties++)(g) == 0u)
+      {
+        best = u;
+      }
+    }
+    current = best;
+  }
+}
+
+} // namespace detail
+
+// Order crossover (OX).
+template <typename C, typename G>
+auto order_crossover(const C& parent1, const C& parent2, G& g) -> std::array<C, 2u>
+{
+  static_assert(std::is_integral<detail::value_type<C>>::value,
+                "genes must be integral");
+
+  auto children = std::array<C, 2u>{{parent1, parent2}};
+
+  const auto n = detail::check_sizes(parent1, parent2);
+  if (n < 2u)
+    return children;
+
+  const auto cut = detail::segment(n, g);
+  const auto p1 = detail::data(parent1);
+  const auto p2 = detail::data(parent2);
+
+  detail::order_child(p1, p2, detail::data(children[0]), n, cut.first, cut.second);
+  detail::order_child(p2, p1, detail::data(children[1]), n, cut.first, cut.second);
+
+  return children;
+}
+
+// Partially mapped crossover (PMX).
+template <typename C, typename G>
+auto partially_mapped_crossover(const C& parent1, const C& parent2, G& g)
+  -> std::array<C, 2u>
+{
+  static_assert(std::is_integral<detail::value_type<C>>::value,
+                "genes must be integral");
+
+  auto children = std::array<C, 2u>{{parent2, parent1}};
+
+  const auto n = detail::check_sizes(parent1, parent2);
+  if (n < 2u)
+    return children;
+
+  const auto cut = detail::segment(n, g);
+
+  detail::partially_mapped_child(detail::data(parent1), detail::data(children[0]), n,
+                                 cut.first, cut.second);
+  detail::partially_mapped_child(detail::data(parent2), detail::data(children[1]), n,
+                                 cut.first, cut.second);
+
+  return children;
+}
+
+// Cycle crossover (CX).  Every gene keeps the position it has in one of the parents;
+// the cycles are inherited alternately.
+template <typename C, typename G>
+auto cycle_crossover(const C& parent1, const C& parent2, G&) -> std::array<C, 2u>
+{
+  static_assert(std::is_integral<detail::value_type<C>>::value,
+                "genes must be integral");
+
+  auto children = std::array<C, 2u>{{parent1, parent2}};
+
+  const auto n = detail::check_sizes(parent1, parent2);
+  if (n < 2u)
+    return children;
+
+  const auto p1 = detail::data(parent1);
+  const auto p2 = detail::data(parent2);
+  const auto c1 = detail::data(children[0]);
+  const auto c2 = detail::data(children[1]);
+
+  const auto position = detail::scratch<std::size_t, detail::buffer<0>>(n);
+  const auto visited = detail::scratch<unsigned char, detail::buffer<0>>(n);
+
+  for (std::size_t i = 0u; i < n; ++i)
+    position[detail::index(p1[i])] = i;
+  std::fill(visited, visited + n, 0u);
+
+  auto swapped = false;
+  for (std::size_t start = 0u; start < n; ++start)
+  {
+    if (visited[start])
+      continue;
+
+    auto i = start;
+    do
+    {
+      visited[i] = 1u;
+      if (swapped)
+      {
+        c1[i] = p2[i];
+        c2[i] = p1[i];
+      }
+      i = position[detail::index(p2[i])];
+    } while (i != start);
+
+    swapped = !swapped;
+  }
+
+  return children;
+}
+
+// Edge recombination crossover (ERX).  Children are built, starting from the first gene
+// of each parent, by walking the union of the parents' adjacency graphs.
+template <typename C, typename G>
+auto edge_recombination(const C& parent1, const C& parent2, G& g) -> std::array<C, 2u>
+{
+  static_assert(std::is_integral<detail::value_type<C>>::value,
+                "genes must be integral");
+
+  auto children = std::array<C, 2u>{{parent1, parent2}};
+
+  const auto n = detail::check_sizes(parent1, parent2);
+  if (n < 2u)
+    return children;
+
+  const auto p1 = detail::data(parent1);
+  const auto p2 = detail::data(parent2);
+
+  detail::edge_child(p1, p2, detail::data(children[0]), n, detail::index(p1[0]), g);
+  detail::edge_child(p1, p2, detail::data(children[1]), n, detail::index(p2[0]), g);
+
+  return children;
+}
+
+// Swaps two distinct random positions.
+template <typename C, typename G> auto swap_mutation(C& x, G& g) -> void
+{
+  const auto n = detail::length(x);
+  if (n < 2u)
+    return;
+
+  const auto i = std::uniform_int_distribution<std::size_t>(0u, n - 1u)(g);
+  auto j = std::uniform_int_distribution<std::size_t>(0u, n - 2u)(g);
+  if (j >= i)
+    ++j;
+
+  const auto p = detail::data(x);
+  std::swap(p[i], p[j]);
+}
+
+// Reverses a random segment.
+template <typename C, typename G> auto inversion_mutation(C& x, G& g) -> void
+{
+  const auto n = detail::length(x);
+  if (n < 2u)
+    return;
+
+  const auto cut = detail::segment(n, g);
+  const auto p = detail::data(x);
+  std::reverse(p + cut.first, p + cut.second);
+}
+
+} // namespace permutation
+} // namespace ga
+
+#endif // GA_PERMUTATION_HPP
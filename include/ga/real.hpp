@@ -0,0 +1,237 @@
+// Copyright (c) 2018 Filipe Verri <filipeverri@gmail.com>
+
+#ifndef GA_REAL_HPP
+#define GA_REAL_HPP
+
+#include <ga/contiguous.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+// Operators for real-valued genomes.
+//
+// Genomes are any container with contiguous storage of `float` or `double`, e.g.,
+// `std::vector<double>`, `std::array<float, N>`, or `std::valarray<double>`.  Every
+// operator draws all the random numbers it needs in a batch before running the
+// arithmetic kernels, which have no calls to the random engine nor branches (choices are
+// made by multiplying with 0/1 masks) and thus can be vectorized by the compiler.  The
+// exception is the `std::pow` pass of `sbx` and `polynomial_mutation`, which stays scalar
+// unless the compiler has a vector math library at hand (e.g., GCC with `-ffast-math`
+// and glibc).  Genes are clamped to `[lower, upper]` afterwards.
+//
+// Crossover operators return two children and mutation operators change the individual
+// in-place, so they can be forwarded by `problem::recombine` and `problem::mutate`.
+
+namespace ga
+{
+namespace real
+{
+namespace detail
+{
+using ::ga::detail::check_sizes;
+using ::ga::detail::data;
+using ::ga::detail::length;
+using ::ga::detail::scratch;
+using ::ga::detail::value_type;
+
+template <typename T, typename G> auto uniform(T* out, std::size_t n, G& g) -> void
+{
+  for (std::size_t i = 0u; i < n; ++i)
+    out[i] = std::generate_canonical<T, std::numeric_limits<T>::digits>(g);
+}
+
+template <typename T, typename G> auto normal(T* out, std::size_t n, G& g) -> void
+{
+  auto dist = std::normal_distribution<T>{};
+  for (std::size_t i = 0u; i < n; ++i)
+    out[i] = dist(g);
+}
+
+// 1 if `condition` holds, 0 otherwise.
+template <typename T> auto mask(bool condition) -> T { return condition ? T{1} : T{0}; }
+
+template <typename T> auto power(T* x, std::size_t n, T exponent) -> void
+{
+  for (std::size_t i = 0u; i < n; ++i)
+    x[i] = std::pow(x[i], exponent);
+}
+
+template <typename T> auto clamp(T* x, std::size_t n, T lower, T upper) -> void
+{
+  for (std::size_t i = 0u; i < n; ++i)
+    x[i] = std::min(std::max(x[i], lower), upper);
+}
+
+struct first_tag;
+struct second_tag;
+
+} // namespace detail
+
+// Simulated binary crossover.  Each gene is recombined with chance 0.5 and `eta` is the
+// distribution index (larger values generate children closer to the parents).
+template <typename C, typename G>
+auto sbx(const C& parent1, const C& parent2, detail::value_type<C> eta,
+         detail::value_type<C> lower, detail::value_type<C> upper, G& g)
+  -> std::array<C, 2u>
+{
+  using T = detail::value_type<C>;
+  static_assert(std::is_floating_point<T>::value, "genes must be floating-point");
+
+  auto children = std::array<C, 2u>{{parent1, parent2}};
+
+  const auto n = detail::check_sizes(parent1, parent2);
+  if (n == 0u)
+    return children;
+
+  auto u = detail::scratch<T, detail::first_tag>(n);
+  auto m = detail::scratch<T, detail::second_tag>(n);
+  detail::uniform(u, n, g);
+  detail::uniform(m, n, g);
+
+  const auto p1 = detail::data(parent1);
+  const auto p2 = detail::data(parent2);
+  const auto c1 = detail::data(children[0]);
+  const auto c2 = detail::data(children[1]);
+
+  // `u` becomes the base of the spread factor, then the factor itself.
+  for (std::size_t i = 0u; i < n; ++i)
+  {
+    const auto left = detail::mask<T>(u[i] <= T{0.5});
+    const auto inner = T{2} * u[i];
+    const auto outer = T{1} / (T{2} * (T{1} - u[i]));
+    u[i] = left * inner + (T{1} - left) * outer;
+  }
+
+  detail::power(u, n, T{1} / (eta + T{1}));
+
+  for (std::size_t i = 0u; i < n; ++i)
+  {
+    const auto recombined = detail::mask<T>(m[i] < T{0.5});
+    const auto beta = recombined * u[i] + (T{1} - recombined);
+    c1[i] = T{0.5} * ((T{1} + beta) * p1[i] + (T{1} - beta) * p2[i]);
+    c2[i] = T{0.5} * ((T{1} - beta) * p1[i] + (T{1} + beta) * p2[i]);
+  }
+
+  detail::clamp(c1, n, lower, upper);
+  detail::clamp(c2, n, lower, upper);
+
+  return children;
+}
+
+// Blend crossover.  Each child gene is drawn uniformly from the interval spanned by the
+// parents' genes extended by `alpha` times its length on both sides.
+template <typename C, typename G>
+auto blx(const C& parent1, const C& parent2, detail::value_type<C> alpha,
+         detail::value_type<C> lower, detail::value_type<C> upper, G& g)
+  -> std::array<C, 2u>
+{
+  using T = detail::value_type<C>;
+  static_assert(std::is_floating_point<T>::value, "genes must be floating-point");
+
+  auto children = std::array<C, 2u>{{parent1, parent2}};
+
+  const auto n = detail::check_sizes(parent1, parent2);
+  if (n == 0u)
+    return children;
+
+  auto u1 = detail::scratch<T, detail::first_tag>(n);
+  auto u2 = detail::scratch<T, detail::second_tag>(n);
+  detail::uniform(u1, n, g);
+  detail::uniform(u2, n, g);
+
+  const auto p1 = detail::data(parent1);
+  const auto p2 = detail::data(parent2);
+  const auto c1 = detail::data(children[0]);
+  const auto c2 = detail::data(children[1]);
+
+  const auto spread = T{1} + T{2} * alpha;
+  for (std::size_t i = 0u; i < n; ++i)
+  {
+    const auto low = std::min(p1[i], p2[i]);
+    const auto d = std::max(p1[i], p2[i]) - low;
+    const auto start = low - alpha * d;
+    c1[i] = start + u1[i] * spread * d;
+    c2[i] = start + u2[i] * spread * d;
+  }
+
+  detail::clamp(c1, n, lower, upper);
+  detail::clamp(c2, n, lower, upper);
+
+  return children;
+}
+
+// Polynomial mutation.  Each gene is mutated with chance `rate`; `eta` is the
+// distribution index and the perturbation is scaled by `upper - lower`.
+template <typename C, typename G>
+auto polynomial_mutation(C& x, detail::value_type<C> rate, detail::value_type<C> eta,
+                         detail::value_type<C> lower, detail::value_type<C> upper, G& g)
+  -> void
+{
+  using T = detail::value_type<C>;
+  static_assert(std::is_floating_point<T>::value, "genes must be floating-point");
+
+  const auto n = detail::length(x);
+  if (n == 0u)
+    return;
+
+  auto u = detail::scratch<T, detail::first_tag>(n);
+  auto m = detail::scratch<T, detail::second_tag>(n);
+  detail::uniform(u, n, g);
+  detail::uniform(m, n, g);
+
+  // `m` becomes the perturbation direction and `u` its magnitude.
+  for (std::size_t i = 0u; i < n; ++i)
+  {
+    const auto left = detail::mask<T>(u[i] < T{0.5});
+    const auto mutated = detail::mask<T>(m[i] < rate);
+    m[i] = mutated * (T{2} * left - T{1});
+    u[i] = T{2} * (left * u[i] + (T{1} - left) * (T{1} - u[i]));
+  }
+
+  detail::power(u, n, T{1} / (eta + T{1}));
+
+  const auto p = detail::data(x);
+  const auto range = upper - lower;
+  for (std::size_t i = 0u; i < n; ++i)
+    p[i] += m[i] * (u[i] - T{1}) * range;
+
+  detail::clamp(p, n, lower, upper);
+}
+
+// Gaussian mutation.  Each gene is mutated with chance `rate` by adding a normal
+// deviate with standard deviation `sigma`.
+template <typename C, typename G>
+auto gaussian_mutation(C& x, detail::value_type<C> rate, detail::value_type<C> sigma,
+                       detail::value_type<C> lower, detail::value_type<C> upper, G& g)
+  -> void
+{
+  using T = detail::value_type<C>;
+  static_assert(std::is_floating_point<T>::value, "genes must be floating-point");
+
+  const auto n = detail::length(x);
+  if (n == 0u)
+    return;
+
+  auto z = detail::scratch<T, detail::first_tag>(n);
+  auto m = detail::scratch<T, detail::second_tag>(n);
+  detail::normal(z, n, g);
+  detail::uniform(m, n, g);
+
+  for (std::size_t i = 0u; i < n; ++i)
+    m[i] = detail::mask<T>(m[i] < rate);
+
+  const auto p = detail::data(x);
+  for (std::size_t i = 0u; i < n; ++i)
+    p[i] += m[i] * sigma * z[i];
+
+  detail::clamp(p, n, lower, upper);
+}
+
+} // namespace real
+} // namespace ga
+
+#endif // GA_REAL_HPP
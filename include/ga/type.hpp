@@ -3,6 +3,9 @@
 #ifndef GA_SOLUTION_HPP
 #define GA_SOLUTION_HPP
 
+#include <chrono>
+#include <cstddef>
+
 namespace ga
 {
 
@@ -12,6 +15,76 @@ template <typename Individual, typename Fitness> struct solution
   Fitness fitness;
 };
 
+// How the result of `problem::improve` is used.  Lamarckian improvement replaces both
+// individual and fitness; Baldwinian improvement only replaces the fitness.
+enum class write_back
+{
+  lamarckian,
+  baldwinian
+};
+
+// Memetic settings for problems that define `problem::improve`.  Each offspring (each
+// elite) is improved with chance `offspring_rate` (`elite_rate`).  An improvement calls
+// `problem::improve` up to `step_budget` times, stopping earlier once `time_budget` has
+// elapsed (zero means no time limit).  Improvements run on up to `thread_count` threads.
+// Under Baldwinian write-back, elites are evaluated again before being improved, and
+// nothing is improved while resampling noisy fitness.
+struct improvement_policy
+{
+  double offspring_rate = 0.0;
+  double elite_rate = 0.0;
+  std::size_t step_budget = 1u;
+  std::chrono::nanoseconds time_budget = std::chrono::nanoseconds::zero();
+  write_back mode = write_back::lamarckian;
+  std::size_t thread_count = 1u;
+};
+
+// Settings of offspring breeding.  With more than one thread, offspring are bred in
+// blocks of `block_size` children (rounded up to whole recombinations), each with its
+// own random engine, by up to `thread_count` threads kept alive across generations.
+// If `pin_threads` is set, they are pinned to cores spread over the allowed ones, so the
+// heap memory allocated by the children each one breeds is first touched on its core's
+// NUMA node.  The offspring buffer itself is allocated by the calling thread.
+struct breeding_policy
+{
+  std::size_t thread_count = 1u;
+  std::size_t block_size = 64u;
+  bool pin_threads = false;
+};
+
+// Confidence bound used to race solutions competing for elite slots.  `standard_error`
+// uses `width` times the standard error of the mean; `hoeffding` assumes samples lie in
+// an interval of length `range` and holds with probability `1 - delta`.
+enum class race_bound
+{
+  standard_error,
+  hoeffding
+};
+
+// Settings for problems with noisy single evaluation and floating-point fitness.
+// Resampling is enabled when `max_samples > 1`.  Every solution is evaluated at least
+// `min_samples` times and at most `max_samples` times, and up to `evaluation_budget`
+// extra evaluations per generation are spent racing solutions whose rank relative to
+// the elite boundary is still uncertain.
+struct resampling_policy
+{
+  std::size_t min_samples = 1u;
+  std::size_t max_samples = 1u;
+  std::size_t evaluation_budget = 0u;
+  race_bound bound = race_bound::standard_error;
+  double width = 2.0;
+  double range = 1.0;
+  double delta = 0.05;
+};
+
+// Running statistics of the fitness samples of a solution (Welford's algorithm).
+struct sample_statistics
+{
+  std::size_t count;
+  double mean;
+  double m2;
+};
+
 } // namespace ga
 
 #endif // GA_SOLUTION_HPP
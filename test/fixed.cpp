@@ -0,0 +1,59 @@
+#include "ga/fixed_algorithm.hpp"
+
+#include <numeric>
+
+class problem
+{
+public:
+  using individual_type = int;
+  using generator_type = std::mt19937;
+  using fitness_type = double;
+
+  auto evaluate(int x, generator_type&) const -> double { return x; }
+
+  auto mutate(int& x, generator_type&) const -> void { x <<= 1; }
+
+  auto recombine(int a, int b, generator_type&) const -> std::array<int, 3u>
+  {
+    return {{a ^ b, b + b, a}};
+  };
+};
+
+static auto assert_throw(bool assertion, const char* msg) -> void
+{
+  if (!assertion)
+    throw std::runtime_error{msg};
+}
+
+int main()
+{
+  static constexpr auto population_size = 10u;
+  static constexpr auto elite_count = 2u;
+
+  auto population = std::array<int, population_size>();
+  std::iota(population.begin(), population.end(), 0);
+
+  auto model =
+    ga::make_fixed_algorithm<elite_count>(problem{}, population, std::mt19937{17});
+
+  static_assert(decltype(model)::elite_count() == elite_count, "wrong elite count");
+  static_assert(decltype(model)::population_size == population_size,
+                "wrong population size");
+
+  assert_throw(std::is_sorted(model.population().begin(),
+                              model.population().begin() + elite_count,
+                              [](const decltype(model)::solution_type& a,
+                                 const decltype(model)::solution_type& b) {
+                                return a.fitness < b.fitness;
+                              }),
+               "elite is not sorted");
+  assert_throw(model.population()[0].fitness == 0.0, "wrong best solution");
+
+  for (auto t = 0u; t < 3; ++t)
+  {
+    model.iterate();
+    for (const auto& s : model.population())
+      assert_throw(s.fitness == static_cast<double>(s.x), "wrong fitness");
+    assert_throw(model.population()[0].fitness == 0.0, "elite has been lost");
+  }
+}
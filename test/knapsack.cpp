@@ -41,6 +41,15 @@ public:
     return result;
   }
 
+  // Cheap first stage: overweight bags are worth nothing, and the others can't be worth
+  // more than every item together.
+  auto bound(const individual_type& x, generator_type&) const -> std::array<double, 2u>
+  {
+    if (weights[x].sum() > capacity)
+      return {{0.0, 0.0}};
+    return {{-values[0].sum(), -values[1].sum()}};
+  }
+
   auto mutate(individual_type& x, generator_type& g) const -> void
   {
     for (auto& allele : x)
@@ -75,6 +84,9 @@ private:
 static_assert(ga::meta::Problem<knapsack>::value,
               "Knapsack problem doesn't comply with ga::Problem concept");
 
+static_assert(ga::meta::StagedEvaluation<knapsack>::value,
+              "Knapsack problem doesn't comply with ga::StagedEvaluation concept");
+
 template <typename F>
 static auto generate_random_valarray(std::size_t size, F f)
   -> std::valarray<typename std::result_of<F()>::type>
@@ -143,4 +155,6 @@ int main()
     std::cout << ' ' << -solution.fitness[0] << ' ' << -solution.fitness[1];
     std::cout << " ]\n";
   }
+
+  std::cout << "Avoided evaluations: " << algorithm.avoided_evaluations() << '\n';
 }
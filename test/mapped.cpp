@@ -0,0 +1,118 @@
+#include "ga/mapped_algorithm.hpp"
+
+#include <limits>
+#include <numeric>
+
+class sphere
+{
+public:
+  using individual_type = std::array<double, 64u>;
+  using generator_type = std::mt19937;
+  using fitness_type = double;
+
+  auto evaluate(const individual_type& x, generator_type&) const -> double
+  {
+    return std::inner_product(x.begin(), x.end(), x.begin(), 0.0);
+  }
+
+  auto mutate(individual_type& x, generator_type& g) const -> void
+  {
+    for (auto& v : x)
+      if (ga::draw(1.0 / x.size(), g))
+        v += std::normal_distribution<double>(0.0, 0.1)(g);
+  }
+
+  auto recombine(const individual_type& a, const individual_type& b,
+                 generator_type& g) const -> std::array<individual_type, 3u>
+  {
+    auto child = a;
+    for (std::size_t i = 0u; i < child.size(); ++i)
+      if (ga::draw(0.5, g))
+        child[i] = b[i];
+    return {{child, a, b}};
+  }
+};
+
+static auto assert_throw(bool assertion, const char* msg) -> void
+{
+  if (!assertion)
+    throw std::runtime_error{msg};
+}
+
+static auto random_individual(std::mt19937& g) -> sphere::individual_type
+{
+  auto x = sphere::individual_type{};
+  for (auto& v : x)
+    v = std::uniform_real_distribution<double>(-1.0, 1.0)(g);
+  return x;
+}
+
+int main()
+{
+  static constexpr auto population_size = 1000u;
+  static constexpr auto elite_count = 10u;
+
+  // Sizes are checked before any file is created.
+  auto missing = ga::mapped_options{};
+  missing.directory = "/nonexistent";
+
+  bool failed = false;
+  try
+  {
+    ga::make_mapped_algorithm(sphere{}, 1u, 1u, random_individual, std::mt19937{},
+                              missing);
+  }
+  catch (const std::invalid_argument&)
+  {
+    failed = true;
+  }
+  assert_throw(failed, "wrong elitism check");
+
+  failed = false;
+  try
+  {
+    ga::make_mapped_algorithm(sphere{}, std::numeric_limits<std::size_t>::max() / 2u, 1u,
+                              random_individual, std::mt19937{}, missing);
+  }
+  catch (const std::invalid_argument&)
+  {
+    failed = true;
+  }
+  assert_throw(failed, "wrong population size check");
+
+  // Small chunks, so breeding crosses many chunk boundaries.
+  auto options = ga::mapped_options{};
+  options.chunk_bytes = 100u * sizeof(sphere::individual_type) + 1u;
+
+  auto model = ga::make_mapped_algorithm(sphere{}, population_size, elite_count,
+                                         random_individual, std::mt19937{17}, options);
+
+  const auto check = [&] {
+    auto g = std::mt19937{};
+    for (std::size_t i = 0u; i < model.size(); ++i)
+      assert_throw(model.fitness()[i] == model.problem().evaluate(model.individual(i), g),
+                   "fitness doesn't match individual");
+
+    for (std::size_t i = 1u; i < elite_count; ++i)
+      assert_throw(model.fitness()[i - 1u] <= model.fitness()[i], "elite is not sorted");
+
+    for (auto i = elite_count; i < model.size(); ++i)
+      assert_throw(model.fitness()[elite_count - 1u] <= model.fitness()[i],
+                   "elite is not the best");
+  };
+
+  check();
+  const auto initial = model.fitness().front();
+
+  auto best = initial;
+  for (auto t = 0u; t < 30u; ++t)
+  {
+    model.iterate();
+    check();
+    assert_throw(model.fitness().front() <= best, "elite has been lost");
+    best = model.fitness().front();
+  }
+
+  assert_throw(best < initial, "no progress");
+  assert_throw(model.at(0u).fitness == best, "wrong solution");
+}
@@ -0,0 +1,149 @@
+#include "ga/algorithm.hpp"
+
+#include <cstdlib>
+#include <numeric>
+
+// Individuals are integers and the optimum is zero.  `improve` takes one step towards
+// it, so improved solutions are easy to recognize.
+class problem
+{
+public:
+  using individual_type = int;
+  using generator_type = std::mt19937;
+  using fitness_type = int;
+
+  auto evaluate(int x, generator_type&) const -> int { return std::abs(x); }
+
+  auto mutate(int& x, generator_type& g) const -> void
+  {
+    x += std::uniform_int_distribution<int>(-3, 3)(g);
+  }
+
+  auto recombine(int a, int b, generator_type&) const -> std::array<int, 2u>
+  {
+    return {{a, b}};
+  };
+
+  auto improve(int& x, int& fitness, generator_type&) const -> void
+  {
+    if (x != 0)
+      x += x > 0 ? -1 : 1;
+    fitness = std::abs(x);
+  }
+};
+
+static_assert(ga::meta::Improvement<problem>::value,
+              "Problem doesn't comply with ga::Improvement concept");
+
+static auto assert_throw(bool assertion, const char* msg) -> void
+{
+  if (!assertion)
+    throw std::runtime_error{msg};
+}
+
+static auto make_model(ga::improvement_policy policy) -> ga::algorithm<problem>
+{
+  auto population = std::vector<int>(40u);
+  std::iota(population.begin(), population.end(), 100);
+
+  auto model = ga::make_algorithm(problem{}, std::move(population), 2u, std::mt19937{17});
+  model.improvement() = policy;
+  return model;
+}
+
+int main()
+{
+  // Lamarckian: individuals and fitness are consistent and converge quickly.
+  {
+    auto policy = ga::improvement_policy{};
+    policy.offspring_rate = 1.0;
+    policy.elite_rate = 1.0;
+    policy.step_budget = 10u;
+
+    auto model = make_model(policy);
+    for (auto t = 0u; t < 10u; ++t)
+      model.iterate();
+
+    for (const auto& s : model.population())
+      assert_throw(s.fitness == std::abs(s.x), "inconsistent lamarckian solution");
+    assert_throw(model.population().front().fitness == 0, "lamarckian didn't converge");
+  }
+
+  // Baldwinian: only the fitness reflects the improvement.
+  {
+    auto policy = ga::improvement_policy{};
+    policy.offspring_rate = 1.0;
+    policy.step_budget = 5u;
+    policy.mode = ga::write_back::baldwinian;
+
+    auto model = make_model(policy);
+    model.iterate();
+
+    // Every child is far from the optimum, so all of them have improved fitness.
+    auto improved = std::size_t{0u};
+    for (const auto& s : model.population())
+      if (s.fitness == std::abs(s.x) - 5)
+        ++improved;
+    assert_throw(improved == model.population().size() - model.elite_count(),
+                 "wrong baldwinian solution");
+  }
+
+  // Baldwinian elites are evaluated again before each improvement, so improvements
+  // don't pile up on a stale fitness.
+  {
+    auto policy = ga::improvement_policy{};
+    policy.elite_rate = 1.0;
+    policy.step_budget = 5u;
+    policy.mode = ga::write_back::baldwinian;
+
+    auto model = make_model(policy);
+    auto improved = std::size_t{0u};
+    for (auto t = 0u; t < 10u; ++t)
+    {
+      model.iterate();
+      for (std::size_t i = 0u; i < model.elite_count(); ++i)
+      {
+        const auto& s = model.population()[i];
+        assert_throw(s.fitness == std::abs(s.x) || s.fitness == std::abs(s.x) - 5,
+                     "wrong baldwinian elite");
+        if (s.fitness != std::abs(s.x))
+          ++improved;
+      }
+    }
+    assert_throw(improved > 0u, "baldwinian elites were not improved");
+  }
+
+  // Results don't depend on the number of threads.
+  {
+    auto policy = ga::improvement_policy{};
+    policy.offspring_rate = 0.5;
+    policy.elite_rate = 0.5;
+    policy.step_budget = 3u;
+
+    auto serial = make_model(policy);
+    policy.thread_count = 4u;
+    auto parallel = make_model(policy);
+
+    for (auto t = 0u; t < 5u; ++t)
+    {
+      serial.iterate();
+      parallel.iterate();
+    }
+
+    for (std::size_t i = 0u; i < serial.population().size(); ++i)
+    {
+      assert_throw(serial.population()[i].x == parallel.population()[i].x,
+                   "parallel improvement changed the result");
+      assert_throw(serial.population()[i].fitness == parallel.population()[i].fitness,
+                   "parallel improvement changed the result");
+    }
+  }
+
+  // Without improvement, the algorithm behaves as usual.
+  {
+    auto model = make_model(ga::improvement_policy{});
+    model.iterate();
+    for (const auto& s : model.population())
+      assert_throw(s.fitness == std::abs(s.x), "inconsistent solution");
+  }
+}
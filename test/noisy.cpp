@@ -0,0 +1,153 @@
+#include "ga/algorithm.hpp"
+
+#include <memory>
+#include <numeric>
+
+// Individuals are integers whose true fitness is the value itself, observed with
+// Gaussian noise.
+class problem
+{
+public:
+  using individual_type = int;
+  using generator_type = std::mt19937;
+  using fitness_type = double;
+
+  auto evaluate(int x, generator_type& g) const -> double
+  {
+    ++*evaluations;
+    return x + std::normal_distribution<double>(0.0, 4.0)(g);
+  }
+
+  auto mutate(int&, generator_type&) const -> void {}
+
+  auto recombine(int a, int b, generator_type&) const -> std::array<int, 2u>
+  {
+    return {{a, b}};
+  };
+
+  std::shared_ptr<std::size_t> evaluations = std::make_shared<std::size_t>(0u);
+};
+
+static_assert(ga::meta::NoisyEvaluation<problem>::value,
+              "Problem doesn't comply with ga::NoisyEvaluation concept");
+
+// Improvement only reports a bogus fitness, which must never reach the statistics.
+class improving_problem : public problem
+{
+public:
+  auto improve(int&, double& fitness, generator_type&) const -> void
+  {
+    ++*improvements;
+    fitness -= 1000.0;
+  }
+
+  std::shared_ptr<std::size_t> improvements = std::make_shared<std::size_t>(0u);
+};
+
+static_assert(ga::meta::Improvement<improving_problem>::value,
+              "Problem doesn't comply with ga::Improvement concept");
+
+static auto assert_throw(bool assertion, const char* msg) -> void
+{
+  if (!assertion)
+    throw std::runtime_error{msg};
+}
+
+int main()
+{
+  static constexpr auto population_size = 20u;
+  static constexpr auto elite_count = 4u;
+
+  auto population = std::vector<int>(population_size);
+  std::iota(population.begin(), population.end(), 0);
+
+  auto model = ga::make_algorithm(problem{}, population, elite_count, std::mt19937{17});
+  const auto evaluations = model.problem().evaluations;
+
+  // Disabled by default.
+  model.iterate();
+  assert_throw(model.samples().empty(), "resampling should be disabled");
+
+  auto& policy = model.resampling();
+  policy.min_samples = 3u;
+  policy.max_samples = 100u;
+  policy.evaluation_budget = 500u;
+
+  for (auto t = 0u; t < 5u; ++t)
+  {
+    const auto before = *evaluations;
+    model.iterate();
+
+    // Children are evaluated once by `iterate` and every solution is topped up to
+    // `min_samples` (elites only when resampling is enabled), plus at most
+    // `evaluation_budget` extra samples.
+    const auto spent = *evaluations - before;
+    assert_throw(spent <= (population_size - elite_count) +
+                            policy.min_samples * population_size +
+                            policy.evaluation_budget,
+                 "evaluation budget exceeded");
+
+    const auto& samples = model.samples();
+    assert_throw(samples.size() == population_size, "misaligned statistics");
+
+    for (std::size_t i = 0u; i < population_size; ++i)
+    {
+      assert_throw(samples[i].count >= policy.min_samples, "too few samples");
+      assert_throw(samples[i].count <= policy.max_samples, "too many samples");
+      assert_throw(model.population()[i].fitness == samples[i].mean,
+                   "fitness is not the sample mean");
+    }
+  }
+
+  // With enough samples, elites are the truly best individuals in the population.
+  auto worst_elite = model.population().front().x;
+  for (std::size_t i = 0u; i < elite_count; ++i)
+    worst_elite = std::max(worst_elite, model.population()[i].x);
+  for (auto i = elite_count; i < population_size; ++i)
+    assert_throw(model.population()[i].x >= worst_elite, "racing kept a lucky elite");
+
+  // Hoeffding bound.
+  policy.bound = ga::race_bound::hoeffding;
+  policy.range = 20.0;
+  model.iterate();
+  for (const auto& s : model.samples())
+    assert_throw(s.count >= policy.min_samples, "too few samples");
+
+  // Disabling resampling drops the statistics.
+  policy.max_samples = 1u;
+  model.iterate();
+  assert_throw(model.samples().empty(), "resampling should be disabled");
+
+  // Improved solutions are sampled again by `evaluate` only.  Under Baldwinian
+  // write-back, nothing of the improvement would be kept, so it's skipped.
+  for (const auto mode : {ga::write_back::lamarckian, ga::write_back::baldwinian})
+  {
+    auto improving =
+      ga::make_algorithm(improving_problem{}, population, elite_count, std::mt19937{17});
+
+    improving.resampling() = policy;
+    improving.resampling().max_samples = 100u;
+
+    improving.improvement().offspring_rate = 1.0;
+    improving.improvement().elite_rate = 1.0;
+    improving.improvement().step_budget = 1u;
+    improving.improvement().mode = mode;
+
+    for (auto t = 0u; t < 3u; ++t)
+    {
+      improving.iterate();
+      for (std::size_t i = 0u; i < population_size; ++i)
+      {
+        const auto& stats = improving.samples()[i];
+        assert_throw(stats.count >= policy.min_samples, "too few samples");
+        assert_throw(stats.mean > -100.0, "improved fitness used as a sample");
+        assert_throw(improving.population()[i].fitness == stats.mean,
+                     "fitness is not the sample mean");
+      }
+    }
+
+    const auto improvements = *improving.problem().improvements;
+    assert_throw((mode == ga::write_back::baldwinian) == (improvements == 0u),
+                 "wrong number of improvements");
+  }
+}
@@ -0,0 +1,206 @@
+#include "ga/algorithm.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <set>
+
+// Each recombination returns three children, which doesn't divide the block size.
+class problem
+{
+public:
+  using individual_type = std::vector<double>;
+  using generator_type = std::mt19937;
+  using fitness_type = double;
+
+  auto evaluate(const individual_type& x, generator_type&) const -> double
+  {
+    return std::inner_product(x.begin(), x.end(), x.begin(), 0.0);
+  }
+
+  auto mutate(individual_type& x, generator_type& g) const -> void
+  {
+    ++*mutations;
+    for (auto& v : x)
+      if (ga::draw(0.1, g))
+        v += std::normal_distribution<double>(0.0, 0.1)(g);
+  }
+
+  auto recombine(const individual_type& a, const individual_type& b,
+                 generator_type& g) const -> std::array<individual_type, 3u>
+  {
+    ++*recombinations;
+    auto child = a;
+    for (std::size_t i = 0u; i < child.size(); ++i)
+      if (ga::draw(0.5, g))
+        child[i] = b[i];
+    return {{child, a, b}};
+  }
+
+  std::shared_ptr<std::atomic<std::size_t>> mutations =
+    std::make_shared<std::atomic<std::size_t>>(0u);
+  std::shared_ptr<std::atomic<std::size_t>> recombinations =
+    std::make_shared<std::atomic<std::size_t>>(0u);
+};
+
+static_assert(ga::meta::RecombinationSize<problem>::value == 3u,
+              "wrong number of children per recombination");
+
+// Not default-constructible, so breeding falls back to serial.
+class boxed
+{
+public:
+  explicit boxed(int x)
+    : x{x}
+  {
+  }
+
+  int x;
+};
+
+class boxed_problem
+{
+public:
+  using individual_type = boxed;
+  using generator_type = std::mt19937;
+  using fitness_type = int;
+
+  auto evaluate(const boxed& b, generator_type&) const -> int { return b.x; }
+  auto mutate(boxed& b, generator_type&) const -> void { b.x <<= 1; }
+  auto recombine(const boxed& a, const boxed& b, generator_type&) const
+    -> std::array<boxed, 2u>
+  {
+    return {{boxed{a.x ^ b.x}, boxed{b.x + b.x}}};
+  }
+};
+
+static auto assert_throw(bool assertion, const char* msg) -> void
+{
+  if (!assertion)
+    throw std::runtime_error{msg};
+}
+
+static constexpr auto population_size = 203u;
+static constexpr auto elite_count = 3u;
+
+static auto make_model(std::size_t thread_count, bool pin) -> ga::algorithm<problem>
+{
+  auto g = std::mt19937{17};
+  auto population = std::vector<problem::individual_type>(population_size);
+  for (auto& x : population)
+  {
+    x.resize(16u);
+    for (auto& v : x)
+      v = std::uniform_real_distribution<double>(-1.0, 1.0)(g);
+  }
+
+  auto model = ga::make_algorithm(problem{}, std::move(population), elite_count, g);
+  model.breeding().thread_count = thread_count;
+  model.breeding().block_size = 7u;
+  model.breeding().pin_threads = pin;
+  return model;
+}
+
+int main()
+{
+  auto two = make_model(2u, true);
+  auto four = make_model(4u, false);
+  auto serial = make_model(1u, false);
+
+  const auto initial = two.population().front().fitness;
+
+  for (auto t = 0u; t < 20u; ++t)
+  {
+    const auto before = two.problem().mutations->load();
+    const auto recombinations = two.problem().recombinations->load();
+    const auto serial_recombinations = serial.problem().recombinations->load();
+
+    two.iterate();
+    four.iterate();
+    serial.iterate();
+
+    // Surplus children are discarded without being mutated.
+    const auto mutated = two.problem().mutations->load() - before;
+    assert_throw(mutated == population_size - elite_count, "wrong number of mutations");
+
+    // As many children are discarded as in the serial loop.
+    assert_throw(two.problem().recombinations->load() - recombinations ==
+                   serial.problem().recombinations->load() - serial_recombinations,
+                 "wrong number of recombinations");
+
+    assert_throw(two.population().size() == population_size, "wrong population size");
+    assert_throw(serial.population().size() == population_size, "wrong population size");
+
+    // Same blocks, same results regardless of the number of threads.
+    for (std::size_t i = 0u; i < population_size; ++i)
+    {
+      assert_throw(two.population()[i].x == four.population()[i].x,
+                   "thread count changed the result");
+      assert_throw(two.population()[i].fitness == four.population()[i].fitness,
+                   "thread count changed the result");
+    }
+  }
+
+  assert_throw(two.population().front().fitness < initial, "no progress");
+
+  // Copies breed on workers of their own and match the original.
+  {
+    auto copy = four;
+    copy.iterate();
+    four.iterate();
+    for (std::size_t i = 0u; i < population_size; ++i)
+      assert_throw(copy.population()[i].x == four.population()[i].x,
+                   "copy changed the result");
+  }
+
+  // Workers are reused across calls and the first exception is rethrown.
+  {
+    // Thread ids may be recycled, so each thread counts the calls it has served instead.
+    static thread_local std::size_t calls = 0u;
+
+    auto pool = ga::detail::worker_pool{};
+    auto mutex = std::mutex{};
+    auto served = std::multiset<std::size_t>();
+    const auto record = [&](std::size_t i) {
+      if (i % 3u != 0u)
+        return;
+      std::lock_guard<std::mutex> lock{mutex};
+      served.insert(++calls);
+    };
+
+    // Each of the three workers takes one of the indexes 0, 3 and 6 per call.
+    for (auto t = 0u; t < 10u; ++t)
+      pool.run(9u, 3u, record, true);
+    assert_throw(served.count(10u) == 3u, "workers weren't reused");
+    assert_throw(calls == 0u, "caller ran a chunk");
+
+    auto thrown = false;
+    try
+    {
+      pool.run(8u, 3u, [](std::size_t i) {
+        if (i == 5u)
+          throw std::logic_error{"chunk"};
+      });
+    }
+    catch (const std::logic_error&)
+    {
+      thrown = true;
+    }
+    assert_throw(thrown, "exception wasn't rethrown");
+
+    auto count = std::atomic<std::size_t>{0u};
+    pool.run(8u, 3u, [&](std::size_t) { ++count; });
+    assert_throw(count == 8u, "pool unusable after an exception");
+  }
+
+  auto population = std::vector<boxed>();
+  for (auto i = 0; i < 10; ++i)
+    population.emplace_back(i);
+
+  auto model =
+    ga::make_algorithm(boxed_problem{}, std::move(population), 1u, std::mt19937{17});
+  model.breeding().thread_count = 4u;
+  model.iterate();
+  assert_throw(model.population().size() == 10u, "wrong population size");
+}
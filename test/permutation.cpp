@@ -0,0 +1,240 @@
+#include "ga/algorithm.hpp"
+#include "ga/permutation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+using tour = std::vector<int>;
+
+static auto assert_throw(bool assertion, const char* msg) -> void
+{
+  if (!assertion)
+    throw std::runtime_error{msg};
+}
+
+static auto is_permutation(const tour& x, std::size_t n) -> bool
+{
+  if (x.size() != n)
+    return false;
+  auto seen = std::vector<bool>(n, false);
+  for (const auto v : x)
+  {
+    if (v < 0 || static_cast<std::size_t>(v) >= n || seen[v])
+      return false;
+    seen[v] = true;
+  }
+  return true;
+}
+
+static auto random_tour(std::size_t n, std::mt19937& g) -> tour
+{
+  auto x = tour(n);
+  std::iota(x.begin(), x.end(), 0);
+  std::shuffle(x.begin(), x.end(), g);
+  return x;
+}
+
+// Cut points drawn by the operators, replayed from a copy of the engine.
+static auto segment(std::size_t n, std::mt19937 g) -> std::pair<std::size_t, std::size_t>
+{
+  auto dist = std::uniform_int_distribution<std::size_t>(0u, n);
+  const auto a = dist(g);
+  const auto b = dist(g);
+  return {std::min(a, b), std::max(a, b)};
+}
+
+// Textbook OX: the donor's segment is kept in place and the other genes fill the
+// remaining positions, from `b` onwards, in the order they appear in `other` from `b`.
+static auto order_child(const tour& donor, const tour& other, std::size_t a,
+                        std::size_t b) -> tour
+{
+  const auto n = donor.size();
+  auto child = donor;
+  auto k = b % n;
+  for (std::size_t t = 0u; t < n; ++t)
+  {
+    const auto v = other[(b + t) % n];
+    if (std::find(donor.begin() + a, donor.begin() + b, v) != donor.begin() + b)
+      continue;
+    child[k] = v;
+    k = (k + 1u) % n;
+  }
+  return child;
+}
+
+// Textbook PMX: the donor's segment is kept in place and the other genes come from
+// `other`, following the mapping `donor[i] -> other[i]` out of the segment.
+static auto partially_mapped_child(const tour& donor, const tour& other, std::size_t a,
+                                   std::size_t b) -> tour
+{
+  const auto n = donor.size();
+  auto child = donor;
+  for (std::size_t i = 0u; i < n; ++i)
+  {
+    if (i >= a && i < b)
+      continue;
+
+    auto v = other[i];
+    for (;;)
+    {
+      const auto it = std::find(donor.begin() + a, donor.begin() + b, v);
+      if (it == donor.begin() + b)
+        break;
+      v = other[static_cast<std::size_t>(it - donor.begin())];
+    }
+    child[i] = v;
+  }
+  return child;
+}
+
+// Cities are evenly spaced on a circle, so the optimal tour visits them in order.
+class circle
+{
+public:
+  using individual_type = tour;
+  using generator_type = std::mt19937;
+  using fitness_type = double;
+
+  explicit circle(int crossover)
+    : crossover{crossover}
+  {
+  }
+
+  auto evaluate(const individual_type& x, generator_type&) const -> double
+  {
+    auto total = 0.0;
+    const auto n = x.size();
+    for (std::size_t i = 0u; i < n; ++i)
+    {
+      const auto angle = 2.0 * 3.141592653589793 *
+                         std::abs(x[i] - x[(i + 1u) % n]) / static_cast<double>(n);
+      total += std::sqrt(2.0 - 2.0 * std::cos(angle));
+    }
+    return total;
+  }
+
+  auto mutate(individual_type& x, generator_type& g) const -> void
+  {
+    if (ga::draw(0.3, g))
+      ga::permutation::inversion_mutation(x, g);
+    if (ga::draw(0.1, g))
+      ga::permutation::swap_mutation(x, g);
+  }
+
+  auto recombine(const individual_type& parent1, const individual_type& parent2,
+                 generator_type& g) const -> std::array<individual_type, 2u>
+  {
+    switch (crossover)
+    {
+    case 0:
+      return ga::permutation::order_crossover(parent1, parent2, g);
+    case 1:
+      return ga::permutation::partially_mapped_crossover(parent1, parent2, g);
+    case 2:
+      return ga::permutation::cycle_crossover(parent1, parent2, g);
+    default:
+      return ga::permutation::edge_recombination(parent1, parent2, g);
+    }
+  }
+
+private:
+  int crossover;
+};
+
+static_assert(ga::meta::Problem<circle>::value,
+              "Circle problem doesn't comply with ga::Problem concept");
+
+int main()
+{
+  auto g = std::mt19937{17};
+
+  for (const auto n : {0u, 1u, 2u, 3u, 10u, 257u})
+  {
+    for (auto t = 0u; t < 20u; ++t)
+    {
+      const auto a = random_tour(n, g);
+      const auto b = random_tour(n, g);
+
+      for (const auto& child : ga::permutation::order_crossover(a, b, g))
+        assert_throw(is_permutation(child, n), "invalid OX child");
+
+      for (const auto& child : ga::permutation::partially_mapped_crossover(a, b, g))
+        assert_throw(is_permutation(child, n), "invalid PMX child");
+
+      for (const auto& child : ga::permutation::edge_recombination(a, b, g))
+        assert_throw(is_permutation(child, n), "invalid ERX child");
+
+      for (const auto& child : ga::permutation::cycle_crossover(a, b, g))
+      {
+        assert_throw(is_permutation(child, n), "invalid CX child");
+        for (std::size_t i = 0u; i < n; ++i)
+          assert_throw(child[i] == a[i] || child[i] == b[i], "CX gene out of place");
+      }
+
+      auto x = a;
+      ga::permutation::swap_mutation(x, g);
+      assert_throw(is_permutation(x, n), "invalid swap mutation");
+      if (n >= 2u)
+        assert_throw(x != a, "swap mutation had no effect");
+
+      ga::permutation::inversion_mutation(x, g);
+      assert_throw(is_permutation(x, n), "invalid inversion mutation");
+    }
+  }
+
+  // OX and PMX children match the textbook definitions.
+  for (const auto n : {2u, 3u, 10u, 64u})
+  {
+    for (auto t = 0u; t < 200u; ++t)
+    {
+      const auto a = random_tour(n, g);
+      const auto b = random_tour(n, g);
+
+      auto cut = segment(n, g);
+      const auto ox = ga::permutation::order_crossover(a, b, g);
+      for (auto i = cut.first; i < cut.second; ++i)
+        assert_throw(ox[0][i] == a[i] && ox[1][i] == b[i], "OX moved the segment");
+      assert_throw(ox[0] == order_child(a, b, cut.first, cut.second), "wrong OX child");
+      assert_throw(ox[1] == order_child(b, a, cut.first, cut.second), "wrong OX child");
+
+      cut = segment(n, g);
+      const auto pmx = ga::permutation::partially_mapped_crossover(a, b, g);
+      assert_throw(pmx[0] == partially_mapped_child(a, b, cut.first, cut.second),
+                   "wrong PMX child");
+      assert_throw(pmx[1] == partially_mapped_child(b, a, cut.first, cut.second),
+                   "wrong PMX child");
+    }
+  }
+
+  // Identical parents must produce identical children.
+  {
+    const auto a = random_tour(50u, g);
+    for (const auto& child : ga::permutation::order_crossover(a, a, g))
+      assert_throw(child == a, "OX changed identical parents");
+    for (const auto& child : ga::permutation::partially_mapped_crossover(a, a, g))
+      assert_throw(child == a, "PMX changed identical parents");
+    for (const auto& child : ga::permutation::cycle_crossover(a, a, g))
+      assert_throw(child == a, "CX changed identical parents");
+  }
+
+  for (auto crossover = 0; crossover < 4; ++crossover)
+  {
+    static constexpr auto city_count = 30u;
+
+    auto population = std::vector<tour>();
+    for (auto i = 0u; i < 50u; ++i)
+      population.push_back(random_tour(city_count, g));
+
+    auto model = ga::make_algorithm(circle{crossover}, std::move(population), 2u, g);
+    const auto initial = model.population().front().fitness;
+
+    for (auto t = 0u; t < 100u; ++t)
+      model.iterate();
+
+    for (const auto& s : model.population())
+      assert_throw(is_permutation(s.x, city_count), "invalid individual");
+    assert_throw(model.population().front().fitness < initial, "no progress");
+  }
+}
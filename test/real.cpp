@@ -0,0 +1,124 @@
+#include "ga/algorithm.hpp"
+#include "ga/real.hpp"
+
+#include <numeric>
+#include <valarray>
+
+class sphere
+{
+public:
+  using individual_type = std::vector<double>;
+  using generator_type = std::mt19937;
+  using fitness_type = double;
+
+  explicit sphere(bool blend)
+    : blend{blend}
+  {
+  }
+
+  auto evaluate(const individual_type& x, generator_type&) const -> double
+  {
+    return std::inner_product(x.begin(), x.end(), x.begin(), 0.0);
+  }
+
+  auto mutate(individual_type& x, generator_type& g) const -> void
+  {
+    if (blend)
+      ga::real::gaussian_mutation(x, 1.0 / x.size(), 0.1, lower, upper, g);
+    else
+      ga::real::polynomial_mutation(x, 1.0 / x.size(), 20.0, lower, upper, g);
+  }
+
+  auto recombine(const individual_type& parent1, const individual_type& parent2,
+                 generator_type& g) const -> std::array<individual_type, 2u>
+  {
+    if (!ga::draw(0.9, g))
+      return {{parent1, parent2}};
+    if (blend)
+      return ga::real::blx(parent1, parent2, 0.5, lower, upper, g);
+    return ga::real::sbx(parent1, parent2, 15.0, lower, upper, g);
+  }
+
+  static constexpr double lower = -5.0;
+  static constexpr double upper = 5.0;
+
+private:
+  bool blend;
+};
+
+constexpr double sphere::lower;
+constexpr double sphere::upper;
+
+static_assert(ga::meta::Problem<sphere>::value,
+              "Sphere problem doesn't comply with ga::Problem concept");
+
+static auto assert_throw(bool assertion, const char* msg) -> void
+{
+  if (!assertion)
+    throw std::runtime_error{msg};
+}
+
+static auto run(bool blend) -> void
+{
+  static constexpr auto dimension = 30u;
+  static constexpr auto population_size = 50u;
+
+  auto generator = std::mt19937{17};
+  auto gene = std::uniform_real_distribution<double>(sphere::lower, sphere::upper);
+
+  auto population = std::vector<sphere::individual_type>(population_size);
+  for (auto& x : population)
+  {
+    x.resize(dimension);
+    for (auto& v : x)
+      v = gene(generator);
+  }
+
+  auto model =
+    ga::make_algorithm(sphere{blend}, std::move(population), 2u, std::move(generator));
+
+  const auto initial = model.population().front().fitness;
+
+  for (auto t = 0u; t < 100; ++t)
+    model.iterate();
+
+  for (const auto& s : model.population())
+  {
+    assert_throw(s.x.size() == dimension, "wrong dimension");
+    for (const auto v : s.x)
+      assert_throw(v >= sphere::lower && v <= sphere::upper, "gene out of bounds");
+  }
+
+  assert_throw(model.population().front().fitness < 0.5 * initial, "no progress");
+}
+
+int main()
+{
+  run(false);
+  run(true);
+
+  // Other contiguous containers.
+  auto g = std::mt19937{17};
+  auto a = std::valarray<float>(0.0f, 8u);
+  auto b = std::valarray<float>(1.0f, 8u);
+  const auto children = ga::real::sbx(a, b, 2.0f, 0.0f, 1.0f, g);
+  for (const auto& child : children)
+    for (const auto v : child)
+      assert_throw(v >= 0.0f && v <= 1.0f, "gene out of bounds");
+
+  auto c = std::array<double, 4u>{{0.0, 0.0, 0.0, 0.0}};
+  ga::real::gaussian_mutation(c, 1.0, 10.0, -1.0, 1.0, g);
+  for (const auto v : c)
+    assert_throw(v >= -1.0 && v <= 1.0, "gene out of bounds");
+
+  bool failed = false;
+  try
+  {
+    ga::real::blx(std::vector<double>(2u), std::vector<double>(3u), 0.5, 0.0, 1.0, g);
+  }
+  catch (const std::invalid_argument&)
+  {
+    failed = true;
+  }
+  assert_throw(failed, "wrong size check");
+}
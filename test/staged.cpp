@@ -0,0 +1,119 @@
+#include "ga/algorithm.hpp"
+
+#include <memory>
+#include <numeric>
+
+// Fitness is the individual itself and the bound is slightly optimistic.
+class problem
+{
+public:
+  using individual_type = int;
+  using generator_type = std::mt19937;
+  using fitness_type = double;
+
+  auto evaluate(int x, generator_type&) const -> double
+  {
+    ++*evaluations;
+    return x;
+  }
+
+  auto bound(int x, generator_type&) const -> double { return x - 0.5; }
+
+  auto mutate(int& x, generator_type& g) const -> void
+  {
+    x += std::uniform_int_distribution<int>(-2, 2)(g);
+  }
+
+  auto recombine(int a, int b, generator_type&) const -> std::array<int, 2u>
+  {
+    return {{a, b}};
+  };
+
+  std::shared_ptr<std::size_t> evaluations = std::make_shared<std::size_t>(0u);
+};
+
+static_assert(ga::meta::StagedEvaluation<problem>::value,
+              "Problem doesn't comply with ga::StagedEvaluation concept");
+
+// Each improvement step moves the individual and its fitness down by one.
+class improving_problem : public problem
+{
+public:
+  auto improve(int& x, double& fitness, generator_type&) const -> void
+  {
+    --x;
+    fitness -= 1.0;
+  }
+};
+
+static_assert(ga::meta::Improvement<improving_problem>::value,
+              "Problem doesn't comply with ga::Improvement concept");
+
+static auto assert_throw(bool assertion, const char* msg) -> void
+{
+  if (!assertion)
+    throw std::runtime_error{msg};
+}
+
+int main()
+{
+  static constexpr auto population_size = 50u;
+  static constexpr auto elite_count = 5u;
+
+  auto population = std::vector<int>(population_size);
+  std::iota(population.begin(), population.end(), 0);
+
+  auto model = ga::make_algorithm(problem{}, std::move(population), elite_count,
+                                  std::mt19937{17});
+  const auto evaluations = model.problem().evaluations;
+
+  assert_throw(*evaluations == population_size, "initial population not evaluated");
+  assert_throw(model.avoided_evaluations() == 0u, "wrong avoided evaluations");
+
+  for (auto t = 0u; t < 10u; ++t)
+  {
+    const auto before = *evaluations + model.avoided_evaluations();
+    model.iterate();
+
+    // Every child is either evaluated or skipped.
+    assert_throw(*evaluations + model.avoided_evaluations() - before ==
+                   population_size - elite_count,
+                 "wrong number of evaluations");
+
+    // Elites are always fully evaluated.
+    for (std::size_t i = 0u; i < elite_count; ++i)
+      assert_throw(model.population()[i].fitness == model.population()[i].x,
+                   "elite has bound as fitness");
+
+    // Skipped children are worse than every elite.
+    for (auto i = elite_count; i < population_size; ++i)
+    {
+      const auto& s = model.population()[i];
+      if (s.fitness != s.x)
+        assert_throw(s.fitness > model.population()[elite_count - 1u].fitness,
+                     "skipped child could be an elite");
+    }
+  }
+
+  assert_throw(model.avoided_evaluations() > 0u, "no evaluation was avoided");
+
+  // Children selected for improvement are fully evaluated first, so improvement never
+  // starts from a bound.
+  {
+    auto population = std::vector<int>(population_size);
+    std::iota(population.begin(), population.end(), 0);
+
+    auto improving = ga::make_algorithm(improving_problem{}, std::move(population),
+                                        elite_count, std::mt19937{17});
+    improving.improvement().offspring_rate = 1.0;
+    improving.improvement().step_budget = 50u;
+
+    for (auto t = 0u; t < 5u; ++t)
+    {
+      improving.iterate();
+      for (const auto& s : improving.population())
+        assert_throw(s.fitness == s.x, "improvement started from a bound");
+    }
+    assert_throw(improving.avoided_evaluations() == 0u, "wrong avoided evaluations");
+  }
+}